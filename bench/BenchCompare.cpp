@@ -0,0 +1,377 @@
+#include "scenarios.h"
+
+#include <memory>
+
+using namespace Gekko::Bench;
+
+// Runs every Unit/Vec3 operation and every scenario side by side in Unit, float and double.
+// Reports the throughput of Unit relative to float/double and the error of the Unit and
+// float results against the double result computed from the same inputs.
+namespace {
+
+    const size_t N = 4096;
+    const int ACCURACY_FRAMES = 60;
+    const double LSB = 1.0 / Unit::ONE;
+
+    struct ErrorStats {
+        double max = 0.0;
+        double sum = 0.0;
+        uint64_t count = 0;
+        size_t max_at = 0;
+
+        void Add(double err, size_t index) {
+            if (err > max) {
+                max = err;
+                max_at = index;
+            }
+            sum += err;
+            count++;
+        }
+
+        double Mean() const {
+            return count ? sum / count : 0.0;
+        }
+    };
+
+    struct Comparison {
+        std::string name;
+        ErrorStats unit_error;
+        ErrorStats float_error;
+    };
+
+    // flattens a scalar or vector result into doubles
+    inline int Components(const Unit& v, double* out) {
+        out[0] = Num<Unit>::ToDouble(v);
+        return 1;
+    }
+
+    inline int Components(float v, double* out) {
+        out[0] = v;
+        return 1;
+    }
+
+    inline int Components(double v, double* out) {
+        out[0] = v;
+        return 1;
+    }
+
+    inline int Components(const Vec3& v, double* out) {
+        Components(v.x, out);
+        Components(v.y, out + 1);
+        Components(v.z, out + 2);
+        return 3;
+    }
+
+    template <typename T>
+    int Components(const BasicVec3<T>& v, double* out) {
+        out[0] = v.x;
+        out[1] = v.y;
+        out[2] = v.z;
+        return 3;
+    }
+
+    // element of an operand stream: a scalar (1 raw value) or a vector (3 raw values)
+    template <typename T, bool VEC>
+    struct Elem {
+        using Type = T;
+        static const size_t STRIDE = 1;
+
+        static Type Load(const int32_t* raw) {
+            return Num<T>::FromRaw(raw[0]);
+        }
+    };
+
+    template <typename T>
+    struct Elem<T, true> {
+        using Type = typename Num<T>::Vec;
+        static const size_t STRIDE = 3;
+
+        static Type Load(const int32_t* raw) {
+            return Type(Num<T>::FromRaw(raw[0]), Num<T>::FromRaw(raw[1]), Num<T>::FromRaw(raw[2]));
+        }
+    };
+
+    template <typename T, bool VEC>
+    std::vector<typename Elem<T, VEC>::Type> Load(const std::vector<int32_t>& raw) {
+        std::vector<typename Elem<T, VEC>::Type> out;
+        for (size_t i = 0; i + Elem<T, VEC>::STRIDE <= raw.size(); i += Elem<T, VEC>::STRIDE) {
+            out.push_back(Elem<T, VEC>::Load(&raw[i]));
+        }
+        return out;
+    }
+
+    std::vector<int32_t> RawRange(Rng& rng, size_t count, int32_t lo, int32_t hi) {
+        std::vector<int32_t> raw(count);
+        for (int32_t& r : raw) {
+            r = rng.Range(lo, hi);
+        }
+        return raw;
+    }
+
+    // magnitudes in [lo, hi] with a random sign
+    std::vector<int32_t> RawNonZero(Rng& rng, size_t count, int32_t lo, int32_t hi) {
+        std::vector<int32_t> raw = RawRange(rng, count, lo, hi);
+        for (int32_t& r : raw) {
+            r = (rng.Next() & 1) ? r : -r;
+        }
+        return raw;
+    }
+
+    template <typename T, bool VA, bool VB, typename Op>
+    struct BinaryData {
+        using Scalar = T;
+
+        std::vector<typename Elem<T, VA>::Type> a;
+        std::vector<typename Elem<T, VB>::Type> b;
+        std::vector<decltype(std::declval<Op>()(a[0], b[0]))> out;
+
+        BinaryData(const std::vector<int32_t>& ra, const std::vector<int32_t>& rb, Op op)
+            : a(Load<T, VA>(ra)), b(Load<T, VB>(rb)) {
+            for (size_t i = 0; i < a.size(); ++i) {
+                out.push_back(op(a[i], b[i]));
+            }
+        }
+    };
+
+    class Compare {
+    public:
+        explicit Compare(const Options& opt) : _runner(opt) {}
+
+        // registers the Unit, float and double array forms of 'op' and records their errors
+        template <bool VA, bool VB, typename Op>
+        void Binary(const std::string& name, const std::vector<int32_t>& ra, const std::vector<int32_t>& rb, Op op) {
+            auto u = std::make_shared<BinaryData<Unit, VA, VB, Op>>(ra, rb, op);
+            auto f = std::make_shared<BinaryData<float, VA, VB, Op>>(ra, rb, op);
+            auto d = std::make_shared<BinaryData<double, VA, VB, Op>>(ra, rb, op);
+            Register(name, u, op);
+            Register(name, f, op);
+            Register(name, d, op);
+
+            Comparison c;
+            c.name = name;
+            for (size_t i = 0; i < d->out.size(); ++i) {
+                double ref[3], vu[3], vf[3];
+                int n = Components(d->out[i], ref);
+                Components(u->out[i], vu);
+                Components(f->out[i], vf);
+                for (int k = 0; k < n; ++k) {
+                    c.unit_error.Add(std::fabs(vu[k] - ref[k]), i);
+                    c.float_error.Add(std::fabs(vf[k] - ref[k]), i);
+                }
+            }
+            _comparisons.push_back(c);
+        }
+
+        template <typename Op>
+        void Unary(const std::string& name, const std::vector<int32_t>& ra, Op op) {
+            // unary ops reuse the binary path with an ignored second operand
+            auto wrapped = [op](const auto& x, const auto&) { return op(x); };
+            Binary<false, false>(name, ra, ra, wrapped);
+        }
+
+        int Run() {
+            return _runner.Run();
+        }
+
+        const std::vector<Comparison>& Comparisons() const {
+            return _comparisons;
+        }
+
+        // mean ns/op of one form, 0 when it was filtered out
+        double NsPerOp(const std::string& name, const char* form) const {
+            for (const Result& r : _runner.Results()) {
+                if (r.name == name && r.form == form) {
+                    return r.ns_per_op;
+                }
+            }
+            return 0.0;
+        }
+
+    private:
+        template <typename Data, typename Op>
+        void Register(const std::string& name, std::shared_ptr<Data> data, Op op) {
+            _runner.Add(name, Num<typename Data::Scalar>::Name(), [data, op](uint64_t iters) {
+                const size_t n = data->a.size();
+                for (uint64_t done = 0; done < iters; done += n) {
+                    for (size_t i = 0; i < n; ++i) {
+                        data->out[i] = op(data->a[i], data->b[i]);
+                    }
+                    ClobberMemory();
+                }
+            });
+        }
+
+        Runner _runner;
+        std::vector<Comparison> _comparisons;
+    };
+
+    // positions of one scenario after ACCURACY_FRAMES steps, flattened to doubles
+    template <typename World>
+    std::vector<double> Trajectory(World& world) {
+        for (int i = 0; i < ACCURACY_FRAMES; ++i) {
+            world.Step();
+        }
+        std::vector<double> flat;
+        for (const auto& p : world.Positions()) {
+            double c[3];
+            Components(p, c);
+            flat.insert(flat.end(), c, c + 3);
+        }
+        return flat;
+    }
+
+    // times a scenario in all three types and records the position error after ACCURACY_FRAMES
+    template <typename Make>
+    void Scenario(FrameRunner& runner, std::vector<Comparison>& out, const std::string& name, Make make) {
+        runner.Add(name + "/unit", [make] {
+            auto world = make(Unit{});
+            return [world] { world->Step(); };
+        });
+        runner.Add(name + "/float", [make] {
+            auto world = make(float{});
+            return [world] { world->Step(); };
+        });
+        runner.Add(name + "/double", [make] {
+            auto world = make(double{});
+            return [world] { world->Step(); };
+        });
+
+        std::vector<double> ref = Trajectory(*make(double{}));
+        std::vector<double> vu = Trajectory(*make(Unit{}));
+        std::vector<double> vf = Trajectory(*make(float{}));
+        Comparison c;
+        c.name = name;
+        for (size_t i = 0; i < ref.size(); ++i) {
+            c.unit_error.Add(std::fabs(vu[i] - ref[i]), i / 3);
+            c.float_error.Add(std::fabs(vf[i] - ref[i]), i / 3);
+        }
+        out.push_back(c);
+    }
+
+    double FramesPerSec(const FrameRunner& runner, const std::string& name) {
+        for (const FrameResult& r : runner.Results()) {
+            if (r.name == name) {
+                return r.frames_per_sec;
+            }
+        }
+        return 0.0;
+    }
+
+    double Ratio(double num, double den) {
+        return den > 0.0 ? num / den : 0.0;
+    }
+
+    void PrintHeader(const char* what) {
+        std::printf("\n%-28s %10s %10s %12s %12s %12s %12s\n", what, "vs float", "vs double",
+            "unit max", "unit mean", "float max", "float mean");
+    }
+
+    void PrintRow(const Comparison& c, double vs_float, double vs_double) {
+        std::printf("%-28s %9.2fx %9.2fx %12.3g %12.3g %12.3g %12.3g\n", c.name.c_str(), vs_float, vs_double,
+            c.unit_error.max, c.unit_error.Mean(), c.float_error.max, c.float_error.Mean());
+    }
+
+    void WriteComparison(FILE* f, const Comparison& c, double vs_float, double vs_double, bool last) {
+        std::fprintf(f, "    {\"name\": ");
+        JsonString(f, c.name);
+        std::fprintf(f,
+            ", \"unit_speed_vs_float\": %.4f, \"unit_speed_vs_double\": %.4f"
+            ", \"unit_max_error\": %.9g, \"unit_mean_error\": %.9g, \"unit_max_error_lsb\": %.3f, \"unit_max_error_at\": %llu"
+            ", \"float_max_error\": %.9g, \"float_mean_error\": %.9g}%s\n",
+            vs_float, vs_double, c.unit_error.max, c.unit_error.Mean(), c.unit_error.max / LSB,
+            static_cast<unsigned long long>(c.unit_error.max_at), c.float_error.max, c.float_error.Mean(), last ? "" : ",");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt = Options::Parse(argc, argv);
+    std::string json_path = opt.json_path;
+    opt.json_path.clear();
+
+    Rng rng(0x436F6D70617265ull);
+    const int32_t R = 100 * Unit::ONE;
+    std::vector<int32_t> a = RawRange(rng, N, -R, R);
+    std::vector<int32_t> b = RawRange(rng, N, -R, R);
+    std::vector<int32_t> nonzero = RawNonZero(rng, N, Unit::HALF, R);
+    std::vector<int32_t> positive = RawRange(rng, N, 0, 1000 * Unit::ONE);
+    std::vector<int32_t> va = RawRange(rng, 3 * N, -R, R);
+    std::vector<int32_t> vb = RawRange(rng, 3 * N, -R, R);
+    std::vector<int32_t> vnonzero = RawNonZero(rng, 3 * N, Unit::HALF, R);
+
+    std::printf("== operations (array form) ==\n");
+    Compare ops(opt);
+    ops.Binary<false, false>("operator+", a, b, [](const auto& x, const auto& y) { return x + y; });
+    ops.Binary<false, false>("operator-", a, b, [](const auto& x, const auto& y) { return x - y; });
+    ops.Binary<false, false>("operator*", a, b, [](const auto& x, const auto& y) { return x * y; });
+    ops.Binary<false, false>("operator/", a, nonzero, [](const auto& x, const auto& y) { return x / y; });
+    ops.Unary("Sqrt", positive, [](const auto& x) { return Num<std::decay_t<decltype(x)>>::Sqrt(x); });
+    ops.Binary<true, true>("Vec3::operator+", va, vb, [](const auto& x, const auto& y) { return x + y; });
+    ops.Binary<true, true>("Vec3::operator*", va, vb, [](const auto& x, const auto& y) { return x * y; });
+    ops.Binary<true, true>("Vec3::operator/", va, vnonzero, [](const auto& x, const auto& y) { return x / y; });
+    ops.Binary<true, false>("Vec3::operator*(scalar)", va, b, [](const auto& x, const auto& y) { return x * y; });
+    ops.Binary<true, false>("Vec3::operator/(scalar)", va, nonzero, [](const auto& x, const auto& y) { return x / y; });
+    ops.Binary<true, true>("Vec3::Dot", va, vb, [](const auto& x, const auto& y) { return x.Dot(y); });
+    if (ops.Run() != 0) {
+        return 1;
+    }
+
+    std::printf("\n== scenarios ==\n");
+    FrameRunner scenes(opt);
+    std::vector<Comparison> scene_errors;
+    Scenario(scenes, scene_errors, "particles.integrate.10000", [](auto tag) {
+        return std::make_shared<ParticleSwarm<decltype(tag)>>(10000);
+    });
+    Scenario(scenes, scene_errors, "nbody.gravity.256", [](auto tag) {
+        return std::make_shared<NBody<decltype(tag)>>(256);
+    });
+    Scenario(scenes, scene_errors, "collision.sweep.2000", [](auto tag) {
+        return std::make_shared<CollisionScene<decltype(tag)>>(2000, 20);
+    });
+    Scenario(scenes, scene_errors, "rollback.resim10.500", [](auto tag) {
+        return std::make_shared<Rollback<decltype(tag)>>(500, 12, 10);
+    });
+    if (scenes.Run() != 0) {
+        return 1;
+    }
+
+    // relative throughput is Unit speed over the other type's speed (>1 means Unit is faster);
+    // errors are absolute, in units, against the double result
+    PrintHeader("operation");
+    std::vector<double> op_vs_float, op_vs_double;
+    for (const Comparison& c : ops.Comparisons()) {
+        double unit_ns = ops.NsPerOp(c.name, "unit");
+        op_vs_float.push_back(Ratio(ops.NsPerOp(c.name, "float"), unit_ns));
+        op_vs_double.push_back(Ratio(ops.NsPerOp(c.name, "double"), unit_ns));
+        PrintRow(c, op_vs_float.back(), op_vs_double.back());
+    }
+
+    PrintHeader("scenario (60 frames)");
+    std::vector<double> scene_vs_float, scene_vs_double;
+    for (const Comparison& c : scene_errors) {
+        double unit_fps = FramesPerSec(scenes, c.name + "/unit");
+        scene_vs_float.push_back(Ratio(unit_fps, FramesPerSec(scenes, c.name + "/float")));
+        scene_vs_double.push_back(Ratio(unit_fps, FramesPerSec(scenes, c.name + "/double")));
+        PrintRow(c, scene_vs_float.back(), scene_vs_double.back());
+    }
+
+    if (!json_path.empty()) {
+        FILE* f = std::fopen(json_path.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "failed to write %s\n", json_path.c_str());
+            return 1;
+        }
+        std::fprintf(f, "{\n  \"compiler\": ");
+        JsonString(f, CompilerName());
+        std::fprintf(f, ",\n  \"accuracy_frames\": %d,\n  \"operations\": [\n", ACCURACY_FRAMES);
+        for (size_t i = 0; i < ops.Comparisons().size(); ++i) {
+            WriteComparison(f, ops.Comparisons()[i], op_vs_float[i], op_vs_double[i], i + 1 == ops.Comparisons().size());
+        }
+        std::fprintf(f, "  ],\n  \"scenarios\": [\n");
+        for (size_t i = 0; i < scene_errors.size(); ++i) {
+            WriteComparison(f, scene_errors[i], scene_vs_float[i], scene_vs_double[i], i + 1 == scene_errors.size());
+        }
+        std::fprintf(f, "  ]\n}\n");
+        std::fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,537 @@
+#include "gekko_math.h"
+#include "gekko_math_convert.h"
+#include "gekko_easing.h"
+#include "gekko_keyframes.h"
+#include "gekko_noise.h"
+#include "gekko_random.h"
+#include "gekko_spline.h"
+#include "bench.h"
+
+#include <vector>
+
+using namespace Gekko::Math;
+using namespace Gekko::Bench;
+
+// Microbenchmarks for every Unit and Vec3 operation, plus the random generators, noise, keyframes,
+// splines and easing.
+// scalar: one operation per iteration with opaque inputs and output, so nothing gets vectorized.
+// array:  the same operation over contiguous arrays, leaving the compiler free to vectorize.
+// batch:  the bulk APIs: float conversions, random fills, noise samplers, keyframe tracks,
+//         spline tessellation and easing.
+namespace {
+
+    const size_t N = 4096;
+    const size_t MASK = N - 1;
+
+    struct Inputs {
+        std::vector<Unit> a, b, nonzero, positive;
+        std::vector<int32_t> raw;
+        std::vector<Vec3> va, vb, vnonzero;
+        std::vector<Unit> out;
+        std::vector<uint8_t> bout;
+        std::vector<Vec3> vout;
+        std::vector<float> fout;
+        std::vector<float> fout3;
+        std::vector<float> fout4;
+        std::vector<float> fx, fy, fz;
+
+        Inputs() {
+            Rng rng(0x6E6B6F4D617468ull);
+            for (size_t i = 0; i < N; ++i) {
+                a.push_back(Unit::From(rng.Range(-100 * Unit::ONE, 100 * Unit::ONE)));
+                b.push_back(Unit::From(rng.Range(-100 * Unit::ONE, 100 * Unit::ONE)));
+                int32_t d = rng.Range(Unit::HALF, 100 * Unit::ONE);
+                nonzero.push_back(Unit::From(rng.Next() & 1 ? d : -d));
+                positive.push_back(Unit::From(rng.Range(0, 1000 * Unit::ONE)));
+            }
+            for (size_t i = 0; i < N; ++i) {
+                va.push_back(Vec3(a[i], b[i], a[(i + 1) & MASK]));
+                vb.push_back(Vec3(b[i], a[(i + 7) & MASK], b[(i + 3) & MASK]));
+                vnonzero.push_back(Vec3(nonzero[i], nonzero[(i + 5) & MASK], nonzero[(i + 11) & MASK]));
+            }
+            for (size_t i = 0; i < N; ++i) {
+                raw.push_back(b[i].Raw());
+            }
+            out.resize(N);
+            bout.resize(N);
+            vout.resize(N);
+            fout.resize(N);
+            fout3.resize(3 * N);
+            fout4.resize(4 * N);
+            fx.resize(N);
+            fy.resize(N);
+            fz.resize(N);
+        }
+    };
+
+    template <typename T, typename Op>
+    void ScalarUnary(uint64_t iters, const std::vector<T>& a, Op op) {
+        for (uint64_t i = 0; i < iters; ++i) {
+            T x = a[i & MASK];
+            DoNotOptimize(x);
+            auto r = op(x);
+            DoNotOptimize(r);
+        }
+    }
+
+    template <typename T, typename U, typename Op>
+    void ScalarBinary(uint64_t iters, const std::vector<T>& a, const std::vector<U>& b, Op op) {
+        for (uint64_t i = 0; i < iters; ++i) {
+            T x = a[i & MASK];
+            U y = b[(i * 7) & MASK];
+            DoNotOptimize(x);
+            DoNotOptimize(y);
+            auto r = op(x, y);
+            DoNotOptimize(r);
+        }
+    }
+
+    // 'iters' is rounded up to whole passes over the arrays
+    template <typename T, typename R, typename Op>
+    void ArrayUnary(uint64_t iters, const std::vector<T>& a, std::vector<R>& out, Op op) {
+        for (uint64_t done = 0; done < iters; done += N) {
+            for (size_t i = 0; i < N; ++i) {
+                out[i] = op(a[i]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    template <typename T, typename U, typename R, typename Op>
+    void ArrayBinary(uint64_t iters, const std::vector<T>& a, const std::vector<U>& b, std::vector<R>& out, Op op) {
+        for (uint64_t done = 0; done < iters; done += N) {
+            for (size_t i = 0; i < N; ++i) {
+                out[i] = op(a[i], b[i]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    // array form of the in-place operator (out op= b)
+    template <typename T, typename U, typename Op>
+    void ArrayInPlace(uint64_t iters, std::vector<T>& out, const std::vector<T>& a, const std::vector<U>& b, Op op) {
+        for (uint64_t done = 0; done < iters; done += N) {
+            for (size_t i = 0; i < N; ++i) {
+                out[i] = a[i];
+                op(out[i], b[i]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    // registers a binary operation in both forms
+    template <typename T, typename U, typename R, typename Op>
+    void AddBinary(Runner& runner, const std::string& name,
+        const std::vector<T>& a, const std::vector<U>& b, std::vector<R>& out, Op op) {
+        runner.Add(name, "scalar", [&a, &b, op](uint64_t n) { ScalarBinary(n, a, b, op); });
+        runner.Add(name, "array", [&a, &b, &out, op](uint64_t n) { ArrayBinary(n, a, b, out, op); });
+    }
+
+    template <typename T, typename R, typename Op>
+    void AddUnary(Runner& runner, const std::string& name, const std::vector<T>& a, std::vector<R>& out, Op op) {
+        runner.Add(name, "scalar", [&a, op](uint64_t n) { ScalarUnary(n, a, op); });
+        runner.Add(name, "array", [&a, &out, op](uint64_t n) { ArrayUnary(n, a, out, op); });
+    }
+
+    void RegisterUnit(Runner& r, Inputs& in) {
+        AddBinary(r, "Unit::operator+", in.a, in.b, in.out, [](Unit x, Unit y) { return x + y; });
+        AddBinary(r, "Unit::operator-", in.a, in.b, in.out, [](Unit x, Unit y) { return x - y; });
+        AddBinary(r, "Unit::operator*", in.a, in.b, in.out, [](Unit x, Unit y) { return x * y; });
+        AddBinary(r, "Unit::operator/", in.a, in.nonzero, in.out, [](Unit x, Unit y) { return x / y; });
+        AddUnary(r, "Unit::operator-(unary)", in.a, in.out, [](Unit x) { return -x; });
+        // comparisons sink the bool itself, the array form into bytes
+        AddBinary(r, "Unit::operator<", in.a, in.b, in.bout, [](Unit x, Unit y) { return x < y; });
+        AddBinary(r, "Unit::operator<=", in.a, in.b, in.bout, [](Unit x, Unit y) { return x <= y; });
+        AddBinary(r, "Unit::operator>", in.a, in.b, in.bout, [](Unit x, Unit y) { return x > y; });
+        AddBinary(r, "Unit::operator>=", in.a, in.b, in.bout, [](Unit x, Unit y) { return x >= y; });
+        AddBinary(r, "Unit::operator==", in.a, in.b, in.bout, [](Unit x, Unit y) { return x == y; });
+        AddBinary(r, "Unit::operator!=", in.a, in.b, in.bout, [](Unit x, Unit y) { return x != y; });
+        AddBinary(r, "Unit::operator<(int32)", in.a, in.raw, in.bout, [](Unit x, int32_t y) { return x < y; });
+        AddBinary(r, "Unit::operator<=(int32)", in.a, in.raw, in.bout, [](Unit x, int32_t y) { return x <= y; });
+        AddBinary(r, "Unit::operator>(int32)", in.a, in.raw, in.bout, [](Unit x, int32_t y) { return x > y; });
+        AddBinary(r, "Unit::operator>=(int32)", in.a, in.raw, in.bout, [](Unit x, int32_t y) { return x >= y; });
+        AddBinary(r, "Min", in.a, in.b, in.out, [](Unit x, Unit y) { return Min(x, y); });
+        AddBinary(r, "Max", in.a, in.b, in.out, [](Unit x, Unit y) { return Max(x, y); });
+        AddUnary(r, "Unit::SqrtNewton", in.positive, in.out, [](Unit x) { return Unit::SqrtNewton(x); });
+        AddUnary(r, "Unit::AsFloat", in.a, in.fout, [](Unit x) { return x.AsFloat(); });
+        r.Add("Unit::AsFloat", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloat(in.a.data(), N, in.fout.data());
+                ClobberMemory();
+            }
+        });
+
+        r.Add("Unit::operator+=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.out, in.a, in.b, [](Unit& x, Unit y) { x += y; });
+        });
+        r.Add("Unit::operator-=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.out, in.a, in.b, [](Unit& x, Unit y) { x -= y; });
+        });
+        r.Add("Unit::operator*=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.out, in.a, in.b, [](Unit& x, Unit y) { x *= y; });
+        });
+        r.Add("Unit::operator/=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.out, in.a, in.nonzero, [](Unit& x, Unit y) { x /= y; });
+        });
+    }
+
+    void RegisterVec3(Runner& r, Inputs& in) {
+        AddBinary(r, "Vec3::operator+", in.va, in.vb, in.vout, [](const Vec3& x, const Vec3& y) { return x + y; });
+        AddBinary(r, "Vec3::operator-", in.va, in.vb, in.vout, [](const Vec3& x, const Vec3& y) { return x - y; });
+        AddBinary(r, "Vec3::operator*", in.va, in.vb, in.vout, [](const Vec3& x, const Vec3& y) { return x * y; });
+        AddBinary(r, "Vec3::operator/", in.va, in.vnonzero, in.vout, [](const Vec3& x, const Vec3& y) { return x / y; });
+        AddBinary(r, "Vec3::operator+(Unit)", in.va, in.b, in.vout, [](const Vec3& x, Unit y) { return x + y; });
+        AddBinary(r, "Vec3::operator-(Unit)", in.va, in.b, in.vout, [](const Vec3& x, Unit y) { return x - y; });
+        AddBinary(r, "Vec3::operator*(Unit)", in.va, in.b, in.vout, [](const Vec3& x, Unit y) { return x * y; });
+        AddBinary(r, "Vec3::operator/(Unit)", in.va, in.nonzero, in.vout, [](const Vec3& x, Unit y) { return x / y; });
+        AddBinary(r, "Vec3::Dot", in.va, in.vb, in.out, [](const Vec3& x, const Vec3& y) { return x.Dot(y); });
+        AddBinary(r, "Vec3::operator==", in.va, in.vb, in.bout, [](const Vec3& x, const Vec3& y) { return x == y; });
+        AddBinary(r, "Vec3::operator!=", in.va, in.vb, in.bout, [](const Vec3& x, const Vec3& y) { return x != y; });
+
+        r.Add("Vec3::operator+=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.vb, [](Vec3& x, const Vec3& y) { x += y; });
+        });
+        r.Add("Vec3::operator-=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.vb, [](Vec3& x, const Vec3& y) { x -= y; });
+        });
+        r.Add("Vec3::operator*=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.vb, [](Vec3& x, const Vec3& y) { x *= y; });
+        });
+        r.Add("Vec3::operator/=", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.vnonzero, [](Vec3& x, const Vec3& y) { x /= y; });
+        });
+        r.Add("Vec3::operator+=(Unit)", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.b, [](Vec3& x, Unit y) { x += y; });
+        });
+        r.Add("Vec3::operator-=(Unit)", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.b, [](Vec3& x, Unit y) { x -= y; });
+        });
+        r.Add("Vec3::operator*=(Unit)", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.b, [](Vec3& x, Unit y) { x *= y; });
+        });
+        r.Add("Vec3::operator/=(Unit)", "array", [&in](uint64_t n) {
+            ArrayInPlace(n, in.vout, in.va, in.nonzero, [](Vec3& x, Unit y) { x /= y; });
+        });
+
+        // the array form writes the three floats directly, the layout the batch forms produce
+        r.Add("Vec3::AsFloat", "scalar", [&in](uint64_t n) {
+            ScalarUnary(n, in.va, [](const Vec3& x) { return x.AsFloat(); });
+        });
+        r.Add("Vec3::AsFloat", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    Vec3F f = in.va[i].AsFloat();
+                    in.fout3[3 * i + 0] = f.x;
+                    in.fout3[3 * i + 1] = f.y;
+                    in.fout3[3 * i + 2] = f.z;
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Vec3::AsFloat", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloatInterleaved(in.va.data(), N, in.fout3.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("Vec3::AsFloat(padded)", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloatPadded(in.va.data(), N, in.fout4.data(), 1.0f);
+                ClobberMemory();
+            }
+        });
+        // render interpolation between two snapshots, converting and blending in one pass
+        r.Add("Vec3::AsFloatLerp", "array", [&in](uint64_t n) {
+            const float alpha = 0.375f;
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    Vec3F p = in.va[i].AsFloat();
+                    Vec3F c = in.vb[i].AsFloat();
+                    in.fout3[3 * i + 0] = p.x * (1.0f - alpha) + c.x * alpha;
+                    in.fout3[3 * i + 1] = p.y * (1.0f - alpha) + c.y * alpha;
+                    in.fout3[3 * i + 2] = p.z * (1.0f - alpha) + c.z * alpha;
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Vec3::AsFloatLerp", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloatLerpInterleaved(in.va.data(), in.vb.data(), N, 0.375f, in.fout3.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("Vec3::AsFloatLerp(padded)", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloatLerpPadded(in.va.data(), in.vb.data(), N, 0.375f, in.fout4.data(), 1.0f);
+                ClobberMemory();
+            }
+        });
+        r.Add("Vec3::AsFloat(soa)", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                AsFloatSoA(in.va.data(), N, in.fx.data(), in.fy.data(), in.fz.data());
+                ClobberMemory();
+            }
+        });
+    }
+
+    // one generator call per element against the four-lane batch fill
+    void RegisterRandom(Runner& r, Inputs& in) {
+        r.Add("Random::Range", "array", [&in](uint64_t n) {
+            static Random rng(1);
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.out[i] = rng.Range(Unit(-100), Unit(100));
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Random::Range", "batch", [&in](uint64_t n) {
+            static RandomBatch rng(1);
+            for (uint64_t done = 0; done < n; done += N) {
+                rng.FillRange(in.out.data(), N, Unit(-100), Unit(100));
+                ClobberMemory();
+            }
+        });
+        r.Add("Random::Gaussian", "array", [&in](uint64_t n) {
+            static Random rng(1);
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.out[i] = rng.Gaussian(Unit(0), Unit(2));
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Random::Gaussian", "batch", [&in](uint64_t n) {
+            static RandomBatch rng(1);
+            for (uint64_t done = 0; done < n; done += N) {
+                rng.FillGaussian(in.out.data(), N, Unit(0), Unit(2));
+                ClobberMemory();
+            }
+        });
+        r.Add("Random::InBox", "array", [&in](uint64_t n) {
+            static Random rng(1);
+            const Vec3 min(Unit(-10), Unit(-10), Unit(-10)), max(Unit(10), Unit(10), Unit(10));
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.vout[i] = rng.InBox(min, max);
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Random::InBox", "batch", [&in](uint64_t n) {
+            static RandomBatch rng(1);
+            const Vec3 min(Unit(-10), Unit(-10), Unit(-10)), max(Unit(10), Unit(10), Unit(10));
+            for (uint64_t done = 0; done < n; done += N) {
+                rng.FillInBox(in.vout.data(), N, min, max);
+                ClobberMemory();
+            }
+        });
+    }
+
+    // one sample per element against the SoA samplers
+    void RegisterNoise(Runner& r, Inputs& in) {
+        r.Add("Noise::Perlin3", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.out[i] = Perlin(Vec3(in.a[i], in.b[i], in.nonzero[i]));
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Noise::Perlin3", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                Perlin(in.a.data(), in.b.data(), in.nonzero.data(), N, in.out.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("Noise::Simplex2", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.out[i] = Simplex(in.a[i], in.b[i]);
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Noise::Simplex2", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                Simplex(in.a.data(), in.b.data(), N, in.out.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("Noise::Simplex3", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                for (size_t i = 0; i < N; ++i) {
+                    in.out[i] = Simplex(Vec3(in.a[i], in.b[i], in.nonzero[i]));
+                }
+                ClobberMemory();
+            }
+        });
+        r.Add("Noise::Simplex3", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += N) {
+                Simplex(in.a.data(), in.b.data(), in.nonzero.data(), N, in.out.data());
+                ClobberMemory();
+            }
+        });
+    }
+
+    // 64 Hermite channels of 32 keys sampled at advancing times: a binary search per track,
+    // cursors per track, and one clip whose channels share the key times
+    struct Keyframes {
+        static const uint32_t KEYS = 32;
+        static const uint32_t CHANNELS = 64;
+
+        std::vector<Keyframe> keys;
+        std::vector<KeyTrack> tracks;
+        std::vector<TrackCursor> cursors;
+        std::vector<Unit> times, values, ins, outs;
+        KeyClip clip;
+        TrackCursor clipCursor;
+        Unit t = Unit(0);
+
+        explicit Keyframes(const Inputs& in) : keys(KEYS * CHANNELS), cursors(CHANNELS) {
+            for (uint32_t k = 0; k < KEYS; ++k) {
+                times.push_back(Unit(static_cast<int32_t>(k)));
+            }
+            for (uint32_t k = 0; k < KEYS; ++k) {
+                for (uint32_t c = 0; c < CHANNELS; ++c) {
+                    const size_t i = k * CHANNELS + c;
+                    keys[c * KEYS + k] = Keyframe{ times[k], in.a[i], in.b[i], in.b[(i + 1) & MASK] };
+                    values.push_back(in.a[i]);
+                    ins.push_back(in.b[i]);
+                    outs.push_back(in.b[(i + 1) & MASK]);
+                }
+            }
+            for (uint32_t c = 0; c < CHANNELS; ++c) {
+                tracks.push_back(KeyTrack(keys.data() + c * KEYS, KEYS, Interpolation::Hermite));
+            }
+            clip = KeyClip(times.data(), KEYS, CHANNELS, Interpolation::Hermite, values.data(), ins.data(), outs.data());
+        }
+
+        // a 60 Hz tick, looping over the clip
+        void Advance() {
+            t += Unit::From(Unit::ONE / 60);
+            if (t >= times[KEYS - 1]) {
+                t = Unit(0);
+            }
+        }
+    };
+
+    void RegisterKeyframes(Runner& r, Inputs& in) {
+        static Keyframes kf(in);
+        r.Add("KeyTrack::Sample", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += Keyframes::CHANNELS) {
+                for (uint32_t c = 0; c < Keyframes::CHANNELS; ++c) {
+                    in.out[c] = kf.tracks[c].Sample(kf.t);
+                }
+                kf.Advance();
+                ClobberMemory();
+            }
+        });
+        r.Add("KeyTrack::Sample", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += Keyframes::CHANNELS) {
+                Sample(kf.tracks.data(), Keyframes::CHANNELS, kf.t, kf.cursors.data(), in.out.data());
+                kf.Advance();
+                ClobberMemory();
+            }
+        });
+        r.Add("KeyClip::Sample", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += Keyframes::CHANNELS) {
+                kf.clip.Sample(kf.t, kf.clipCursor, in.out.data());
+                kf.Advance();
+                ClobberMemory();
+            }
+        });
+    }
+
+    // a 16-point Catmull-Rom rail at 64 points per segment: Evaluate at each parameter against
+    // forward differencing, and arc-length lookups walked with a cursor
+    struct Splines {
+        static const uint32_t POINTS = 16;
+        static const uint32_t STEPS = 64;
+        static const uint32_t COUNT = (POINTS - 1) * STEPS + 1;
+
+        std::vector<Vec3> points;
+        std::vector<Unit> params, lengths;
+        Spline spline;
+        ArcLengthTable table;
+        TrackCursor cursor;
+        Unit distance = Unit(0);
+
+        explicit Splines(const Inputs& in) : points(in.va.begin(), in.va.begin() + POINTS), lengths(COUNT) {
+            spline = Spline(points.data(), POINTS, SplineKind::CatmullRom);
+            for (uint32_t i = 0; i < COUNT; ++i) {
+                params.push_back(Unit::From(static_cast<int32_t>((static_cast<int64_t>(i) * Unit::ONE) / STEPS)));
+            }
+            table = ArcLengthTable(spline, STEPS, lengths.data());
+        }
+    };
+
+    void RegisterSplines(Runner& r, Inputs& in) {
+        static Splines sp(in);
+        r.Add("Spline::Evaluate", "array", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += Splines::COUNT) {
+                sp.spline.Evaluate(sp.params.data(), Splines::COUNT, in.vout.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("Spline::Tessellate", "batch", [&in](uint64_t n) {
+            for (uint64_t done = 0; done < n; done += Splines::COUNT) {
+                sp.spline.Tessellate(Splines::STEPS, in.vout.data());
+                ClobberMemory();
+            }
+        });
+        r.Add("ArcLengthTable::Evaluate", "scalar", [&in](uint64_t n) {
+            const Unit step = sp.table.Length() / Unit(1000);
+            for (uint64_t done = 0; done < n; ++done) {
+                in.vout[0] = sp.table.Evaluate(sp.distance, sp.cursor);
+                sp.distance = sp.distance + step > sp.table.Length() ? Unit(0) : sp.distance + step;
+                ClobberMemory();
+            }
+        });
+    }
+
+    // one polynomial, one table and one piecewise curve over times in [0, 1]
+    void RegisterEasing(Runner& r, Inputs& in) {
+        static std::vector<Unit> t(N);
+        for (size_t i = 0; i < N; ++i) {
+            t[i] = Unit::From(in.positive[i].Raw() % (Unit::ONE + 1));
+        }
+        struct Curve {
+            const char* name;
+            Easing easing;
+        };
+        const Curve curves[] = { { "Ease(CubicInOut)", Easing::CubicInOut }, { "Ease(ElasticOut)", Easing::ElasticOut },
+            { "Ease(BounceOut)", Easing::BounceOut } };
+        for (const Curve& curve : curves) {
+            const Easing easing = curve.easing;
+            r.Add(curve.name, "array", [&in, easing](uint64_t n) {
+                for (uint64_t done = 0; done < n; done += N) {
+                    for (size_t i = 0; i < N; ++i) {
+                        in.out[i] = Ease(easing, t[i]);
+                    }
+                    ClobberMemory();
+                }
+            });
+            r.Add(curve.name, "batch", [&in, easing](uint64_t n) {
+                for (uint64_t done = 0; done < n; done += N) {
+                    Ease(easing, t.data(), N, in.out.data());
+                    ClobberMemory();
+                }
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt = Options::Parse(argc, argv);
+    Inputs in;
+    Runner runner(opt);
+    RegisterUnit(runner, in);
+    RegisterVec3(runner, in);
+    RegisterRandom(runner, in);
+    RegisterNoise(runner, in);
+    RegisterKeyframes(runner, in);
+    RegisterSplines(runner, in);
+    RegisterEasing(runner, in);
+    return runner.Run();
+}
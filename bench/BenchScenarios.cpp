@@ -0,0 +1,60 @@
+#include "scenarios.h"
+#include "gekko_parallel.h"
+
+#include <memory>
+#include <thread>
+
+using namespace Gekko::Bench;
+
+// Macrobenchmarks: frames/s and p50/p99 frame time for whole simulation steps.
+int main(int argc, char** argv) {
+    Options opt = Options::Parse(argc, argv);
+    FrameRunner runner(opt);
+
+    runner.Add("particles.integrate.10000", [] {
+        auto world = std::make_shared<ParticleSwarm<Unit>>(10000);
+        return [world] { world->Step(); };
+    });
+    runner.Add("particles.integrate.10000.parallel", [] {
+        uint32_t threads = std::thread::hardware_concurrency();
+        auto pool = std::make_shared<Gekko::Math::ThreadPool>(threads > 1 ? threads - 1 : 0);
+        auto world = std::make_shared<ParticleSwarm<Unit>>(10000);
+        return [pool, world] {
+            Gekko::Math::ParallelFor(*pool, world->pos.size(), 1024, [&](size_t begin, size_t end) {
+                world->Integrate(begin, end);
+            });
+        };
+    });
+    runner.Add("nbody.gravity.256", [] {
+        auto world = std::make_shared<NBody<Unit>>(256);
+        return [world] { world->Step(); };
+    });
+    runner.Add("collision.sweep.2000", [] {
+        auto world = std::make_shared<CollisionScene<Unit>>(2000, 20);
+        return [world] { world->Step(); };
+    });
+    runner.Add("rollback.resim10.500", [] {
+        auto world = std::make_shared<Rollback<Unit>>(500, 12, 10);
+        return [world] { world->Step(); };
+    });
+
+    // zones only exist when built with GEKKO_MATH_PROFILE
+    if (!opt.trace_path.empty()) {
+#if !defined(GEKKO_MATH_PROFILE)
+        std::fprintf(stderr, "built without GEKKO_MATH_PROFILE, the trace will be empty\n");
+#endif
+        Gekko::Profile::Profiler::Get().Start();
+    }
+    int status = runner.Run();
+    if (!opt.trace_path.empty()) {
+        auto& profiler = Gekko::Profile::Profiler::Get();
+        profiler.Stop();
+        if (!profiler.WriteChromeTrace(opt.trace_path)) {
+            status = 1;
+        }
+        else if (profiler.Dropped() > 0) {
+            std::fprintf(stderr, "%llu zones dropped\n", static_cast<unsigned long long>(profiler.Dropped()));
+        }
+    }
+    return status;
+}
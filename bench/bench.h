@@ -0,0 +1,614 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+#include "gekko_profile.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Minimal self-contained benchmark harness.
+// A benchmark body receives an iteration count and must perform exactly that many operations.
+namespace Gekko::Bench {
+
+    // keeps the compiler from folding away a value we computed but never use
+    template <typename T>
+    inline void DoNotOptimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        static volatile char sink;
+        sink = *reinterpret_cast<volatile char*>(&value);
+#endif
+    }
+
+    inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    inline bool HasCycleCounter() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // time stamp counter (reference cycles), 0 when the target has none
+    inline uint64_t ReadCycles() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    inline uint64_t NowNs() {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    // splitmix64, used to build deterministic input sets
+    struct Rng {
+        uint64_t state;
+
+        explicit Rng(uint64_t seed) : state(seed) {}
+
+        uint64_t Next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // uniform in [lo, hi]
+        int32_t Range(int32_t lo, int32_t hi) {
+            uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+            return static_cast<int32_t>(lo + static_cast<int64_t>(Next() % span));
+        }
+    };
+
+    struct Options {
+        std::string filter;
+        std::string json_path;
+        std::string trace_path;
+        int samples = 15;
+        double warmup_ms = 50.0;
+        double min_sample_ms = 5.0;
+        int frames = 300;
+        int warmup_frames = 30;
+        bool list = false;
+        bool perf = false;
+
+        static Options Parse(int argc, char** argv) {
+            Options opt;
+            for (int i = 1; i < argc; ++i) {
+                const char* arg = argv[i];
+                if (std::strncmp(arg, "--filter=", 9) == 0) {
+                    opt.filter = arg + 9;
+                }
+                else if (std::strncmp(arg, "--json=", 7) == 0) {
+                    opt.json_path = arg + 7;
+                }
+                else if (std::strncmp(arg, "--trace=", 8) == 0) {
+                    opt.trace_path = arg + 8;
+                }
+                else if (std::strncmp(arg, "--samples=", 10) == 0) {
+                    opt.samples = std::max(3, std::atoi(arg + 10));
+                }
+                else if (std::strncmp(arg, "--warmup-ms=", 12) == 0) {
+                    opt.warmup_ms = std::atof(arg + 12);
+                }
+                else if (std::strncmp(arg, "--min-sample-ms=", 16) == 0) {
+                    opt.min_sample_ms = std::atof(arg + 16);
+                }
+                else if (std::strncmp(arg, "--frames=", 9) == 0) {
+                    opt.frames = std::max(1, std::atoi(arg + 9));
+                }
+                else if (std::strncmp(arg, "--warmup-frames=", 16) == 0) {
+                    opt.warmup_frames = std::max(0, std::atoi(arg + 16));
+                }
+                else if (std::strcmp(arg, "--list") == 0) {
+                    opt.list = true;
+                }
+                else if (std::strcmp(arg, "--perf") == 0) {
+                    opt.perf = true;
+                }
+                else {
+                    std::fprintf(stderr,
+                        "usage: %s [--filter=substr] [--json=path] [--trace=path] [--samples=N] "
+                        "[--warmup-ms=N] [--min-sample-ms=N] [--frames=N] [--warmup-frames=N] [--list] [--perf]\n", argv[0]);
+                    std::exit(2);
+                }
+            }
+            return opt;
+        }
+    };
+
+    // hardware counters summed over the kept samples, divided by 'ops' operations or frames
+    struct PerfSummary {
+        PerfReading perf;
+        uint64_t ops = 0;
+
+        bool Has(PerfEvent e) const {
+            return ops > 0 && perf.Has(e);
+        }
+
+        double PerOp(PerfEvent e) const {
+            return perf.Get(e) / ops;
+        }
+
+        double Ipc() const {
+            return perf.Get(PerfEvent::Instructions) / perf.Get(PerfEvent::Cycles);
+        }
+
+        bool HasIpc() const {
+            return Has(PerfEvent::Instructions) && Has(PerfEvent::Cycles) && perf.Get(PerfEvent::Cycles) > 0.0;
+        }
+    };
+
+    struct Result {
+        std::string name;
+        std::string form;
+        uint64_t ops_per_sample = 0;
+        int samples = 0;
+        int rejected = 0;
+        double ns_per_op = 0.0;
+        double ns_per_op_min = 0.0;
+        double ns_per_op_stddev = 0.0;
+        double ops_per_sec = 0.0;
+        double cycles_per_op = 0.0;
+        PerfSummary perf;
+    };
+
+    // per-frame timing of a scenario, see FrameRunner
+    struct FrameResult {
+        std::string name;
+        uint64_t frames = 0;
+        double mean_ns = 0.0;
+        double p50_ns = 0.0;
+        double p99_ns = 0.0;
+        double max_ns = 0.0;
+        double frames_per_sec = 0.0;
+        PerfSummary perf;
+    };
+
+    struct Stats {
+        double mean = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        int kept = 0;
+    };
+
+    inline double Median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        return (n % 2) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+    }
+
+    inline double Percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        double rank = p * (values.size() - 1);
+        size_t lo = static_cast<size_t>(rank);
+        size_t hi = std::min(lo + 1, values.size() - 1);
+        return values[lo] + (values[hi] - values[lo]) * (rank - lo);
+    }
+
+    // rejects samples further than 3 scaled MADs from the median, then summarizes the rest
+    inline Stats RobustStats(const std::vector<double>& values, std::vector<bool>* keep_out = nullptr) {
+        Stats s;
+        double med = Median(values);
+        std::vector<double> dev;
+        dev.reserve(values.size());
+        for (double v : values) {
+            dev.push_back(std::fabs(v - med));
+        }
+        double limit = 3.0 * 1.4826 * Median(dev);
+
+        std::vector<bool> keep(values.size());
+        double sum = 0.0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            keep[i] = limit == 0.0 || std::fabs(values[i] - med) <= limit;
+            if (keep[i]) {
+                s.min = s.kept == 0 ? values[i] : std::min(s.min, values[i]);
+                sum += values[i];
+                s.kept++;
+            }
+        }
+        s.mean = sum / s.kept;
+        double var = 0.0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (keep[i]) {
+                var += (values[i] - s.mean) * (values[i] - s.mean);
+            }
+        }
+        s.stddev = s.kept > 1 ? std::sqrt(var / (s.kept - 1)) : 0.0;
+        if (keep_out) {
+            *keep_out = keep;
+        }
+        return s;
+    }
+
+    inline void JsonString(FILE* f, const std::string& s) {
+        std::fputc('"', f);
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', f);
+            }
+            std::fputc(c, f);
+        }
+        std::fputc('"', f);
+    }
+
+    inline const char* CompilerName() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    inline void PrintPerfHeader(const char* per) {
+        std::printf(" %6s %9s/%-5s %9s/%-5s %9s/%-5s", "IPC", "brmiss", per, "l1dmiss", per, "llcmiss", per);
+    }
+
+    inline void PrintPerfColumns(const PerfSummary& p) {
+        if (p.HasIpc()) {
+            std::printf(" %6.2f", p.Ipc());
+        }
+        else {
+            std::printf(" %6s", "-");
+        }
+        const PerfEvent misses[] = { PerfEvent::BranchMisses, PerfEvent::L1DMisses, PerfEvent::LLCMisses };
+        for (PerfEvent m : misses) {
+            if (p.Has(m)) {
+                std::printf(" %15.5f", p.PerOp(m));
+            }
+            else {
+                std::printf(" %15s", "-");
+            }
+        }
+    }
+
+    // writes ', "perf": {...}' with every counter divided by p.ops, keys suffixed with '_per'
+    inline void WritePerfJson(FILE* f, const PerfSummary& p, const char* per) {
+        if (p.ops == 0) {
+            std::fprintf(f, ", \"perf\": null");
+            return;
+        }
+        std::fprintf(f, ", \"perf\": {");
+        if (p.HasIpc()) {
+            std::fprintf(f, "\"ipc\": %.4f", p.Ipc());
+        }
+        else {
+            std::fprintf(f, "\"ipc\": null");
+        }
+        for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+            PerfEvent ev = static_cast<PerfEvent>(i);
+            if (p.Has(ev)) {
+                std::fprintf(f, ", \"%s_per_%s\": %.6f", PerfEventName(ev), per, p.PerOp(ev));
+            }
+            else {
+                std::fprintf(f, ", \"%s_per_%s\": null", PerfEventName(ev), per);
+            }
+        }
+        std::fprintf(f, "}");
+    }
+
+    inline void OpenPerf(const Options& opt, PerfCounters& perf) {
+        if (opt.perf) {
+            std::string why;
+            if (!perf.Open(&why)) {
+                std::fprintf(stderr, "hardware counters unavailable: %s\n", why.c_str());
+            }
+        }
+    }
+
+    inline bool Selected(const Options& opt, const std::string& name) {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    }
+
+    class Runner {
+    public:
+        using Body = std::function<void(uint64_t)>;
+
+        explicit Runner(const Options& opt) : _opt(opt) {
+            OpenPerf(_opt, _perf);
+        }
+
+        // registers a benchmark, 'form' is scalar / array / simd / scenario
+        void Add(const std::string& name, const std::string& form, Body body) {
+            _entries.push_back({ name, form, std::move(body) });
+        }
+
+        int Run() {
+            if (_opt.list) {
+                for (auto& e : _entries) {
+                    std::printf("%s/%s\n", e.name.c_str(), e.form.c_str());
+                }
+                return 0;
+            }
+
+            std::printf("%-28s %-9s %12s %14s %12s %8s", "benchmark", "form", "ns/op", "ops/s", "cycles/op", "+-%");
+            if (_perf.Available()) {
+                PrintPerfHeader("op");
+            }
+            std::printf("\n");
+            for (auto& e : _entries) {
+                if (!Selected(_opt, e.name + "/" + e.form)) {
+                    continue;
+                }
+                Result r = Measure(e);
+                std::printf("%-28s %-9s %12.3f %14.4g %12.2f %7.2f%%",
+                    r.name.c_str(), r.form.c_str(), r.ns_per_op, r.ops_per_sec, r.cycles_per_op,
+                    r.ns_per_op > 0.0 ? 100.0 * r.ns_per_op_stddev / r.ns_per_op : 0.0);
+                if (_perf.Available()) {
+                    PrintPerfColumns(r.perf);
+                }
+                std::printf("\n");
+                _results.push_back(r);
+            }
+
+            if (!_opt.json_path.empty() && !WriteJson(_opt.json_path)) {
+                std::fprintf(stderr, "failed to write %s\n", _opt.json_path.c_str());
+                return 1;
+            }
+            return 0;
+        }
+
+        const std::vector<Result>& Results() const {
+            return _results;
+        }
+
+    private:
+        struct Entry {
+            std::string name;
+            std::string form;
+            Body body;
+        };
+
+        Result Measure(Entry& e) {
+            // warmup, doubling the batch until one batch covers the minimum sample time
+            uint64_t iters = 1;
+            uint64_t warm_start = NowNs();
+            for (;;) {
+                uint64_t t0 = NowNs();
+                e.body(iters);
+                double ms = (NowNs() - t0) * 1e-6;
+                if (ms >= _opt.min_sample_ms) {
+                    if ((NowNs() - warm_start) * 1e-6 >= _opt.warmup_ms) {
+                        break;
+                    }
+                }
+                else {
+                    iters *= 2;
+                }
+            }
+
+            std::vector<double> ns(_opt.samples);
+            std::vector<double> cyc(_opt.samples);
+            std::vector<PerfReading> hw(_opt.samples);
+            bool perf = _perf.Available();
+            for (int s = 0; s < _opt.samples; ++s) {
+                if (perf) {
+                    _perf.Start();
+                }
+                uint64_t c0 = ReadCycles();
+                uint64_t t0 = NowNs();
+                e.body(iters);
+                uint64_t t1 = NowNs();
+                uint64_t c1 = ReadCycles();
+                if (perf) {
+                    hw[s] = _perf.Stop();
+                }
+                ns[s] = static_cast<double>(t1 - t0) / iters;
+                cyc[s] = static_cast<double>(c1 - c0) / iters;
+            }
+
+            std::vector<bool> keep;
+            Stats st = RobustStats(ns, &keep);
+            double cyc_sum = 0.0;
+            PerfReading hw_sum;
+            for (int s = 0; s < _opt.samples; ++s) {
+                cyc_sum += keep[s] ? cyc[s] : 0.0;
+                if (keep[s]) {
+                    hw_sum += hw[s];
+                }
+            }
+
+            Result r;
+            r.name = e.name;
+            r.form = e.form;
+            r.ops_per_sample = iters;
+            r.samples = _opt.samples;
+            r.rejected = _opt.samples - st.kept;
+            r.ns_per_op = st.mean;
+            r.ns_per_op_min = st.min;
+            r.ns_per_op_stddev = st.stddev;
+            r.ops_per_sec = st.mean > 0.0 ? 1e9 / st.mean : 0.0;
+            r.cycles_per_op = HasCycleCounter() ? cyc_sum / st.kept : 0.0;
+            r.perf.perf = hw_sum;
+            r.perf.ops = iters * hw_sum.samples;
+            return r;
+        }
+
+        bool WriteJson(const std::string& path) const {
+            FILE* f = std::fopen(path.c_str(), "w");
+            if (!f) {
+                return false;
+            }
+            std::fprintf(f, "{\n  \"compiler\": ");
+            JsonString(f, CompilerName());
+            std::fprintf(f, ",\n  \"cycle_counter\": %s,\n  \"benchmarks\": [\n", HasCycleCounter() ? "\"tsc\"" : "null");
+            for (size_t i = 0; i < _results.size(); ++i) {
+                const Result& r = _results[i];
+                std::fprintf(f, "    {\"name\": ");
+                JsonString(f, r.name);
+                std::fprintf(f, ", \"form\": ");
+                JsonString(f, r.form);
+                std::fprintf(f,
+                    ", \"ns_per_op\": %.4f, \"ns_per_op_min\": %.4f, \"ns_per_op_stddev\": %.4f"
+                    ", \"ops_per_sec\": %.1f, \"cycles_per_op\": %.3f"
+                    ", \"ops_per_sample\": %llu, \"samples\": %d, \"rejected\": %d",
+                    r.ns_per_op, r.ns_per_op_min, r.ns_per_op_stddev, r.ops_per_sec, r.cycles_per_op,
+                    static_cast<unsigned long long>(r.ops_per_sample), r.samples, r.rejected);
+                WritePerfJson(f, r.perf, "op");
+                std::fprintf(f, "}%s\n", i + 1 < _results.size() ? "," : "");
+            }
+            std::fprintf(f, "  ]\n}\n");
+            return std::fclose(f) == 0;
+        }
+
+        Options _opt;
+        PerfCounters _perf;
+        std::vector<Entry> _entries;
+        std::vector<Result> _results;
+    };
+
+    // Runs whole-frame scenarios and reports the frame time distribution.
+    // A scenario factory builds a fresh world and returns the function that steps one frame.
+    class FrameRunner {
+    public:
+        using Frame = std::function<void()>;
+        using Factory = std::function<Frame()>;
+
+        explicit FrameRunner(const Options& opt) : _opt(opt) {
+            OpenPerf(_opt, _perf);
+        }
+
+        void Add(const std::string& name, Factory factory) {
+            _entries.push_back({ name, std::move(factory) });
+        }
+
+        int Run() {
+            if (_opt.list) {
+                for (auto& e : _entries) {
+                    std::printf("%s\n", e.name.c_str());
+                }
+                return 0;
+            }
+
+            std::printf("%-36s %8s %12s %12s %12s %12s", "scenario", "frames", "frames/s", "p50 us", "p99 us", "max us");
+            if (_perf.Available()) {
+                PrintPerfHeader("frame");
+            }
+            std::printf("\n");
+            for (auto& e : _entries) {
+                if (!Selected(_opt, e.name)) {
+                    continue;
+                }
+                FrameResult r = Measure(e);
+                std::printf("%-36s %8llu %12.1f %12.2f %12.2f %12.2f", r.name.c_str(),
+                    static_cast<unsigned long long>(r.frames), r.frames_per_sec, r.p50_ns * 1e-3, r.p99_ns * 1e-3, r.max_ns * 1e-3);
+                if (_perf.Available()) {
+                    PrintPerfColumns(r.perf);
+                }
+                std::printf("\n");
+                _results.push_back(r);
+            }
+
+            if (!_opt.json_path.empty() && !WriteJson(_opt.json_path)) {
+                std::fprintf(stderr, "failed to write %s\n", _opt.json_path.c_str());
+                return 1;
+            }
+            return 0;
+        }
+
+        const std::vector<FrameResult>& Results() const {
+            return _results;
+        }
+
+    private:
+        struct Entry {
+            std::string name;
+            Factory factory;
+        };
+
+        FrameResult Measure(Entry& e) {
+            Frame frame = e.factory();
+            for (int i = 0; i < _opt.warmup_frames; ++i) {
+                frame();
+            }
+
+            bool perf = _perf.Available();
+            std::vector<double> ns(_opt.frames);
+            if (perf) {
+                _perf.Start();
+            }
+            for (int i = 0; i < _opt.frames; ++i) {
+                GEKKO_PROFILE_ZONE("frame");
+                uint64_t t0 = NowNs();
+                frame();
+                ns[i] = static_cast<double>(NowNs() - t0);
+            }
+
+            FrameResult r;
+            if (perf) {
+                r.perf.perf = _perf.Stop();
+                r.perf.ops = r.perf.perf.samples > 0 ? _opt.frames : 0;
+            }
+            double sum = 0.0;
+            for (double v : ns) {
+                sum += v;
+                r.max_ns = std::max(r.max_ns, v);
+            }
+            r.name = e.name;
+            r.frames = _opt.frames;
+            r.mean_ns = sum / _opt.frames;
+            r.p50_ns = Percentile(ns, 0.50);
+            r.p99_ns = Percentile(ns, 0.99);
+            r.frames_per_sec = r.mean_ns > 0.0 ? 1e9 / r.mean_ns : 0.0;
+            return r;
+        }
+
+        bool WriteJson(const std::string& path) const {
+            FILE* f = std::fopen(path.c_str(), "w");
+            if (!f) {
+                return false;
+            }
+            std::fprintf(f, "{\n  \"compiler\": ");
+            JsonString(f, CompilerName());
+            std::fprintf(f, ",\n  \"scenarios\": [\n");
+            for (size_t i = 0; i < _results.size(); ++i) {
+                const FrameResult& r = _results[i];
+                std::fprintf(f, "    {\"name\": ");
+                JsonString(f, r.name);
+                std::fprintf(f,
+                    ", \"frames\": %llu, \"frames_per_sec\": %.2f, \"mean_ns\": %.1f"
+                    ", \"p50_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f",
+                    static_cast<unsigned long long>(r.frames), r.frames_per_sec, r.mean_ns, r.p50_ns, r.p99_ns, r.max_ns);
+                WritePerfJson(f, r.perf, "frame");
+                std::fprintf(f, "}%s\n", i + 1 < _results.size() ? "," : "");
+            }
+            std::fprintf(f, "  ]\n}\n");
+            return std::fclose(f) == 0;
+        }
+
+        Options _opt;
+        PerfCounters _perf;
+        std::vector<Entry> _entries;
+        std::vector<FrameResult> _results;
+    };
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "gekko_math.h"
+
+#include <cmath>
+#include <cstdint>
+
+// Uniform numeric interface so scenarios and comparisons can be instantiated for
+// Unit, float and double. Constants are given as Unit raw values, so every type
+// starts from the exact same (representable) numbers.
+namespace Gekko::Bench {
+
+    // plain 3-vector for the floating point instantiations, mirrors the Vec3 operators
+    template <typename T>
+    struct BasicVec3 {
+        T x, y, z;
+
+        BasicVec3() = default;
+        BasicVec3(T xx, T yy, T zz) : x(xx), y(yy), z(zz) {}
+
+        T Dot(const BasicVec3& o) const {
+            return (x * o.x) + (y * o.y) + (z * o.z);
+        }
+
+        BasicVec3 operator+(const BasicVec3& o) const {
+            return BasicVec3(x + o.x, y + o.y, z + o.z);
+        }
+
+        BasicVec3 operator-(const BasicVec3& o) const {
+            return BasicVec3(x - o.x, y - o.y, z - o.z);
+        }
+
+        BasicVec3 operator*(const BasicVec3& o) const {
+            return BasicVec3(x * o.x, y * o.y, z * o.z);
+        }
+
+        BasicVec3 operator/(const BasicVec3& o) const {
+            return BasicVec3(x / o.x, y / o.y, z / o.z);
+        }
+
+        BasicVec3 operator+(T s) const {
+            return BasicVec3(x + s, y + s, z + s);
+        }
+
+        BasicVec3 operator*(T s) const {
+            return BasicVec3(x * s, y * s, z * s);
+        }
+
+        BasicVec3 operator/(T s) const {
+            return BasicVec3(x / s, y / s, z / s);
+        }
+
+        BasicVec3& operator+=(const BasicVec3& o) {
+            return *this = *this + o;
+        }
+
+        BasicVec3& operator-=(const BasicVec3& o) {
+            return *this = *this - o;
+        }
+    };
+
+    template <typename T>
+    struct Num;
+
+    template <>
+    struct Num<Gekko::Math::Unit> {
+        using Type = Gekko::Math::Unit;
+        using Vec = Gekko::Math::Vec3;
+
+        static const char* Name() {
+            return "unit";
+        }
+
+        static Type FromRaw(int32_t raw) {
+            return Type::From(raw);
+        }
+
+        static Type Sqrt(const Type& v) {
+            return Type::SqrtNewton(v);
+        }
+
+        static double ToDouble(const Type& v) {
+            return static_cast<double>(v.Raw()) / Type::ONE;
+        }
+    };
+
+    template <typename T>
+    struct NumFloating {
+        using Type = T;
+        using Vec = BasicVec3<T>;
+
+        static Type FromRaw(int32_t raw) {
+            return static_cast<T>(raw) / static_cast<T>(Gekko::Math::Unit::ONE);
+        }
+
+        static Type Sqrt(Type v) {
+            return std::sqrt(v);
+        }
+
+        static double ToDouble(Type v) {
+            return static_cast<double>(v);
+        }
+    };
+
+    template <>
+    struct Num<float> : NumFloating<float> {
+        static const char* Name() {
+            return "float";
+        }
+    };
+
+    template <>
+    struct Num<double> : NumFloating<double> {
+        static const char* Name() {
+            return "double";
+        }
+    };
+
+    template <typename T>
+    T Clamp(const T& v, const T& lo, const T& hi) {
+        return v < lo ? lo : (hi < v ? hi : v);
+    }
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Optional Linux perf_event hardware counters for the benchmark harness.
+// The counters are opened as one group led by cycles (or the first event that opens), so the
+// kernel schedules them together and ratios such as IPC compare counts from the same window.
+// An event the PMU does not offer only loses its column; on other platforms, or when
+// perf_event_paranoid forbids it, Available() is false.
+namespace Gekko::Bench {
+
+    enum class PerfEvent {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1DMisses,
+        LLCMisses,
+        Count
+    };
+
+    inline const char* PerfEventName(PerfEvent e) {
+        switch (e) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::BranchMisses: return "branch_misses";
+        case PerfEvent::L1DMisses: return "l1d_misses";
+        case PerfEvent::LLCMisses: return "llc_misses";
+        default: return "?";
+        }
+    }
+
+    const int PERF_EVENT_COUNT = static_cast<int>(PerfEvent::Count);
+
+    struct PerfReading {
+        uint64_t value[PERF_EVENT_COUNT] = {};
+        bool valid[PERF_EVENT_COUNT] = {};
+        uint64_t samples = 0;   // readings summed into this one
+
+        bool Has(PerfEvent e) const {
+            return valid[static_cast<int>(e)];
+        }
+
+        double Get(PerfEvent e) const {
+            return static_cast<double>(value[static_cast<int>(e)]);
+        }
+
+        // adds a reading only when it counted exactly the events of the ones already summed, so
+        // every column is a total over the same samples
+        PerfReading& operator+=(const PerfReading& other) {
+            if (other.samples == 0) {
+                return *this;
+            }
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+                if (samples > 0 && valid[i] != other.valid[i]) {
+                    return *this;
+                }
+            }
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+                value[i] += other.value[i];
+                valid[i] = other.valid[i];
+            }
+            samples += other.samples;
+            return *this;
+        }
+    };
+
+    class PerfCounters {
+    public:
+        PerfCounters() {
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+                _fd[i] = -1;
+            }
+        }
+
+        ~PerfCounters() {
+            Close();
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        // opens what it can, returns false (with a reason) when no counter is usable
+        bool Open(std::string* why = nullptr) {
+#if defined(__linux__)
+            int last_errno = 0;
+            _leader = -1;
+            _members = 0;
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                Describe(static_cast<PerfEvent>(i), attr);
+                // members follow the leader's enable state
+                attr.disabled = _leader < 0 ? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                long fd = syscall(SYS_perf_event_open, &attr, 0, -1, _leader, 0);
+                if (fd < 0) {
+                    last_errno = errno;
+                    continue;
+                }
+                _fd[i] = static_cast<int>(fd);
+                _leader = _leader < 0 ? _fd[i] : _leader;
+                _order[_members++] = i;
+            }
+            if (_members == 0 && why) {
+                *why = last_errno == EACCES || last_errno == EPERM
+                    ? "permission denied (see /proc/sys/kernel/perf_event_paranoid)"
+                    : std::string("perf_event_open failed: ") + std::strerror(last_errno);
+            }
+            return _members > 0;
+#else
+            if (why) {
+                *why = "perf_event is only available on Linux";
+            }
+            return false;
+#endif
+        }
+
+        bool Available() const {
+            return _members > 0;
+        }
+
+        void Start() {
+#if defined(__linux__)
+            if (_leader >= 0) {
+                ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        // stops counting and returns the counts since Start(), scaled up when the kernel multiplexed
+        // the group; all events share one enabled/running window, so they are valid together or not at all
+        PerfReading Stop() {
+            PerfReading r;
+#if defined(__linux__)
+            if (_leader < 0) {
+                return r;
+            }
+            ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            // nr, time enabled, time running, then one value per member in the order they were opened
+            uint64_t buf[3 + PERF_EVENT_COUNT] = {};
+            const ssize_t expected = static_cast<ssize_t>((3 + _members) * sizeof(uint64_t));
+            if (read(_leader, buf, sizeof(buf)) != expected || buf[0] != static_cast<uint64_t>(_members) || buf[2] == 0) {
+                return r;
+            }
+            const double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+            for (int k = 0; k < _members; ++k) {
+                r.value[_order[k]] = static_cast<uint64_t>(static_cast<double>(buf[3 + k]) * scale);
+                r.valid[_order[k]] = true;
+            }
+            r.samples = 1;
+#endif
+            return r;
+        }
+
+        void Close() {
+#if defined(__linux__)
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+                if (_fd[i] >= 0 && _fd[i] != _leader) {
+                    close(_fd[i]);
+                }
+                _fd[i] = -1;
+            }
+            // the leader goes last, after its members
+            if (_leader >= 0) {
+                close(_leader);
+                _leader = -1;
+            }
+#endif
+            _members = 0;
+        }
+
+    private:
+#if defined(__linux__)
+        static void Describe(PerfEvent e, perf_event_attr& attr) {
+            const uint64_t read_miss = PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+            switch (e) {
+            case PerfEvent::Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfEvent::Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfEvent::BranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case PerfEvent::L1DMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+                break;
+            case PerfEvent::LLCMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | read_miss;
+                break;
+            default:
+                break;
+            }
+        }
+#endif
+
+        int _fd[PERF_EVENT_COUNT];
+        int _order[PERF_EVENT_COUNT] = {};   // event of each group member, leader first
+        int _leader = -1;
+        int _members = 0;
+    };
+}
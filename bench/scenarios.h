@@ -0,0 +1,295 @@
+#pragma once
+
+#include "numeric.h"
+#include "bench.h"
+#include "gekko_profile.h"
+
+#include <algorithm>
+#include <vector>
+
+// Macro scenarios built on Unit/Vec3: small but complete simulation loops that are
+// stepped once per frame by BenchScenarios. All state stays within the Unit range by
+// construction (walls, periodic boxes and speed clamps), so no step can overflow.
+// Each scenario is a template over the scalar type (see Num) so BenchCompare can run
+// the same workload in float and double from identical initial state.
+namespace Gekko::Bench {
+
+    using Gekko::Math::Unit;
+    using Gekko::Math::Vec3;
+
+    // uniform value in [lo, hi] whole units
+    template <typename T>
+    T RandomReal(Rng& rng, int32_t lo, int32_t hi) {
+        return Num<T>::FromRaw(rng.Range(lo * Unit::ONE, hi * Unit::ONE));
+    }
+
+    template <typename T>
+    typename Num<T>::Vec RandomVec(Rng& rng, int32_t lo, int32_t hi) {
+        T x = RandomReal<T>(rng, lo, hi);
+        T y = RandomReal<T>(rng, lo, hi);
+        T z = RandomReal<T>(rng, lo, hi);
+        return typename Num<T>::Vec(x, y, z);
+    }
+
+    // keeps one axis inside [lo, hi] by mirroring the position and the velocity
+    template <typename T>
+    void Reflect(T& p, T& v, const T& lo, const T& hi) {
+        if (p < lo) {
+            p = lo + (lo - p);
+            v = -v;
+        }
+        else if (hi < p) {
+            p = hi - (p - hi);
+            v = -v;
+        }
+    }
+
+    // particles under gravity bouncing inside a box
+    template <typename T>
+    struct ParticleSwarm {
+        using N = Num<T>;
+        using V = typename N::Vec;
+
+        std::vector<V> pos;
+        std::vector<V> vel;
+        T dt = N::FromRaw(Unit::ONE / 60);
+        V gravity_dt = V(T(0), N::FromRaw(-321454 / 60), T(0));   // -9.81 per second
+        T restitution = N::FromRaw(26214);                        // 0.8
+        T extent = T(50);
+
+        explicit ParticleSwarm(size_t count, uint64_t seed = 1) {
+            Rng rng(seed);
+            for (size_t i = 0; i < count; ++i) {
+                T x = RandomReal<T>(rng, -40, 40);
+                T y = RandomReal<T>(rng, 0, 40);
+                T z = RandomReal<T>(rng, -40, 40);
+                pos.push_back(V(x, y, z));
+                vel.push_back(RandomVec<T>(rng, -5, 5));
+            }
+        }
+
+        const std::vector<V>& Positions() const {
+            return pos;
+        }
+
+        void Step() {
+            GEKKO_PROFILE_ZONE("particles.integrate");
+            Integrate(0, pos.size());
+        }
+
+        // particles are independent, so ranges can be stepped on different threads
+        void Integrate(size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                V& p = pos[i];
+                V& v = vel[i];
+                v += gravity_dt;
+                p += v * dt;
+                if (p.y < T(0)) {
+                    p.y = -p.y;
+                    v.y = -v.y * restitution;
+                }
+                Reflect(p.x, v.x, -extent, extent);
+                Reflect(p.z, v.z, -extent, extent);
+            }
+        }
+    };
+
+    // O(n^2) softened gravity in a periodic box; 1 / sqrt(r^2) stands in for an rsqrt
+    template <typename T>
+    struct NBody {
+        using N = Num<T>;
+        using V = typename N::Vec;
+
+        std::vector<V> pos;
+        std::vector<V> vel;
+        std::vector<V> acc;
+        T dt = N::FromRaw(Unit::ONE / 60);
+        T gm = T(10);
+        T softening = T(1);
+        T max_speed = T(20);
+        T half_box = T(20);
+
+        explicit NBody(size_t count, uint64_t seed = 2) : acc(count) {
+            Rng rng(seed);
+            for (size_t i = 0; i < count; ++i) {
+                pos.push_back(RandomVec<T>(rng, -18, 18));
+                vel.push_back(RandomVec<T>(rng, -1, 1));
+            }
+        }
+
+        const std::vector<V>& Positions() const {
+            return pos;
+        }
+
+        void Step() {
+            Forces();
+            Integrate();
+        }
+
+        void Forces() {
+            GEKKO_PROFILE_ZONE("nbody.forces");
+            const size_t n = pos.size();
+            std::fill(acc.begin(), acc.end(), V(T(0), T(0), T(0)));
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = i + 1; j < n; ++j) {
+                    V d = pos[j] - pos[i];
+                    T r = N::Sqrt(d.Dot(d) + softening);
+                    T inv_r = T(1) / r;
+                    V f = d * (gm * inv_r) * (inv_r * inv_r);
+                    acc[i] += f;
+                    acc[j] -= f;
+                }
+            }
+        }
+
+        void Integrate() {
+            GEKKO_PROFILE_ZONE("nbody.integrate");
+            const size_t n = pos.size();
+            const T box = half_box * T(2);
+            for (size_t i = 0; i < n; ++i) {
+                V& v = vel[i];
+                v += acc[i] * dt;
+                v = V(Clamp(v.x, -max_speed, max_speed), Clamp(v.y, -max_speed, max_speed), Clamp(v.z, -max_speed, max_speed));
+                V& p = pos[i];
+                p += v * dt;
+                T* axes[3] = { &p.x, &p.y, &p.z };
+                for (T* a : axes) {
+                    if (half_box < *a) {
+                        *a -= box;
+                    }
+                    else if (*a < -half_box) {
+                        *a += box;
+                    }
+                }
+            }
+        }
+    };
+
+    // spheres in a box: sort-and-sweep broadphase on x followed by sphere-sphere narrowphase
+    template <typename T>
+    struct CollisionScene {
+        using N = Num<T>;
+        using V = typename N::Vec;
+
+        std::vector<V> pos;
+        std::vector<V> vel;
+        std::vector<uint32_t> order;   // indices sorted by min x, kept between frames
+        T radius = N::FromRaw(Unit::HALF);
+        T dt = N::FromRaw(Unit::ONE / 60);
+        T extent;
+        uint32_t contacts = 0;
+
+        CollisionScene(size_t count, int32_t half_extent, uint64_t seed = 3) : extent(T(half_extent)) {
+            Rng rng(seed);
+            for (size_t i = 0; i < count; ++i) {
+                pos.push_back(RandomVec<T>(rng, -half_extent + 1, half_extent - 1));
+                vel.push_back(RandomVec<T>(rng, -4, 4));
+                order.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        const std::vector<V>& Positions() const {
+            return pos;
+        }
+
+        void Integrate() {
+            GEKKO_PROFILE_ZONE("collision.integrate");
+            for (size_t i = 0; i < pos.size(); ++i) {
+                V& p = pos[i];
+                V& v = vel[i];
+                p += v * dt;
+                Reflect(p.x, v.x, -extent, extent);
+                Reflect(p.y, v.y, -extent, extent);
+                Reflect(p.z, v.z, -extent, extent);
+            }
+        }
+
+        void Broadphase() {
+            GEKKO_PROFILE_ZONE("collision.broadphase");
+            // insertion sort: almost linear because the order barely changes between frames
+            for (size_t i = 1; i < order.size(); ++i) {
+                uint32_t idx = order[i];
+                T key = pos[idx].x;
+                size_t j = i;
+                while (j > 0 && key < pos[order[j - 1]].x) {
+                    order[j] = order[j - 1];
+                    --j;
+                }
+                order[j] = idx;
+            }
+        }
+
+        void Narrowphase() {
+            GEKKO_PROFILE_ZONE("collision.narrowphase");
+            const T diameter = radius * T(2);
+            const T diameter_sq = diameter * diameter;
+            contacts = 0;
+            for (size_t i = 0; i < order.size(); ++i) {
+                uint32_t a = order[i];
+                for (size_t k = i + 1; k < order.size(); ++k) {
+                    uint32_t b = order[k];
+                    V d = pos[b] - pos[a];
+                    if (diameter < d.x) {
+                        break;
+                    }
+                    if (diameter < d.y || diameter < -d.y || diameter < d.z || diameter < -d.z) {
+                        continue;
+                    }
+                    T dist_sq = d.Dot(d);
+                    if (!(dist_sq < diameter_sq) || dist_sq == T(0)) {
+                        continue;
+                    }
+                    T dist = N::Sqrt(dist_sq);
+                    if (dist == T(0)) {
+                        continue;
+                    }
+                    V n = d / dist;
+                    V push = n * ((diameter - dist) / T(2));
+                    pos[a] -= push;
+                    pos[b] += push;
+                    T vn = (vel[a] - vel[b]).Dot(n);
+                    if (T(0) < vn) {
+                        vel[a] -= n * vn;
+                        vel[b] += n * vn;
+                    }
+                    contacts++;
+                }
+            }
+        }
+
+        void Step() {
+            Integrate();
+            Broadphase();
+            Narrowphase();
+        }
+    };
+
+    // rollback: every frame restores the confirmed state and resimulates 'depth' frames
+    template <typename T>
+    struct Rollback {
+        CollisionScene<T> confirmed;
+        CollisionScene<T> predicted;
+        int depth;
+
+        Rollback(size_t count, int32_t half_extent, int resim_depth)
+            : confirmed(count, half_extent, 4), predicted(confirmed), depth(resim_depth) {}
+
+        const std::vector<typename Num<T>::Vec>& Positions() const {
+            return predicted.pos;
+        }
+
+        void Step() {
+            confirmed.Step();
+            {
+                GEKKO_PROFILE_ZONE("rollback.restore");
+                predicted.pos = confirmed.pos;
+                predicted.vel = confirmed.vel;
+                predicted.order = confirmed.order;
+            }
+            GEKKO_PROFILE_ZONE("rollback.resimulate");
+            for (int i = 0; i < depth; ++i) {
+                predicted.Step();
+            }
+        }
+    };
+}
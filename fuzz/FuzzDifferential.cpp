@@ -0,0 +1,636 @@
+#include "gekko_math.h"
+#include "gekko_math_convert.h"
+#include "gekko_easing.h"
+#include "gekko_keyframes.h"
+#include "gekko_noise.h"
+#include "gekko_spline.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Gekko::Math;
+
+// Differential fuzzing: every fast path is paired with the scalar Unit reference it must
+// match bit for bit (raw outputs, and whether it throws). Inputs are edge-heavy raw values.
+// Any mismatch is shrunk to a minimal reproducer that can be replayed with --repro.
+//
+// Built with -DGEKKO_LIBFUZZER (and -fsanitize=fuzzer) the same pairs are driven by libFuzzer:
+// the first byte picks the pair, the following bytes are the raw operands.
+namespace {
+
+    using Raw = std::vector<int32_t>;
+
+    struct Outcome {
+        bool threw = false;
+        std::vector<int64_t> values;
+
+        bool operator==(const Outcome& o) const {
+            return threw == o.threw && values == o.values;
+        }
+    };
+
+    struct Pair {
+        const char* name;
+        int arity;
+        int32_t (*domain)(int32_t v);   // maps any raw value into the inputs the pair is defined for
+        void (*fast)(const Raw& in, Outcome& out);
+        void (*reference)(const Raw& in, Outcome& out);
+    };
+
+    Unit U(int32_t raw) {
+        return Unit::From(raw);
+    }
+
+    Vec3 V(const Raw& in, int first) {
+        return Vec3(U(in[first]), U(in[first + 1]), U(in[first + 2]));
+    }
+
+    // 'count' vectors from consecutive raws, enough to run the SIMD blocks and the scalar tail
+    std::vector<Vec3> Vecs(const Raw& in, int count) {
+        std::vector<Vec3> v;
+        for (int i = 0; i < count; ++i) {
+            v.push_back(V(in, 3 * i));
+        }
+        return v;
+    }
+
+    void Push(Outcome& out, const Unit& u) {
+        out.values.push_back(u.Raw());
+    }
+
+    void Push(Outcome& out, const Vec3& v) {
+        Push(out, v.x);
+        Push(out, v.y);
+        Push(out, v.z);
+    }
+
+    void PushFloat(Outcome& out, float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        out.values.push_back(bits);
+    }
+
+    void PushFloats(Outcome& out, const std::vector<float>& f) {
+        for (float v : f) {
+            PushFloat(out, v);
+        }
+    }
+
+    // per-element reference for the bulk conversions: x y z of each vector, 'pad' after each when set
+    void PushAsFloat(Outcome& out, const Raw& in, int count, const float* pad = nullptr) {
+        for (int i = 0; i < count; ++i) {
+            Vec3F f = V(in, 3 * i).AsFloat();
+            PushFloat(out, f.x);
+            PushFloat(out, f.y);
+            PushFloat(out, f.z);
+            if (pad) {
+                PushFloat(out, *pad);
+            }
+        }
+    }
+
+    const int BULK = 9;
+
+    const int KEYS = 8;
+
+    // KEYS keys from (time step, value, in, out) raws, times increasing by up to one unit
+    std::vector<Keyframe> Keys(const Raw& in) {
+        std::vector<Keyframe> keys(KEYS);
+        int32_t t = 0;
+        for (int k = 0; k < KEYS; ++k) {
+            t += 1 + static_cast<int32_t>(static_cast<uint32_t>(in[4 * k]) % Unit::ONE);
+            keys[k] = Keyframe{ U(t), U(in[4 * k + 1] / 256), U(in[4 * k + 2] / 256), U(in[4 * k + 3] / 256) };
+        }
+        return keys;
+    }
+
+    // sample times from the raws after the keys, up to a unit beyond either end
+    Unit KeyTime(const Raw& in, int i) {
+        return U(static_cast<int32_t>(static_cast<uint32_t>(in[4 * KEYS + i]) % ((KEYS + 2) * Unit::ONE)) - Unit::ONE);
+    }
+
+    // four control points from the first 12 raws as one Bezier and three Catmull-Rom segments, then
+    // BULK distances up to a unit beyond either end of each
+    void ArcLengths(const Raw& in, Outcome& out, bool cursor) {
+        Vec3 points[4];
+        for (int i = 0; i < 12; ++i) {
+            (i % 3 == 0 ? points[i / 3].x : (i % 3 == 1 ? points[i / 3].y : points[i / 3].z)) = U(in[i] / 256);
+        }
+        for (SplineKind kind : { SplineKind::Bezier, SplineKind::CatmullRom }) {
+            Spline spline(points, 4, kind);
+            Unit lengths[3 * 16 + 1];
+            ArcLengthTable table(spline, 16, lengths);
+            TrackCursor walk;
+            const uint32_t range = static_cast<uint32_t>(table.Length().Raw()) + 2 * Unit::ONE;
+            for (int i = 0; i < BULK; ++i) {
+                const Unit d = U(static_cast<int32_t>(static_cast<uint32_t>(in[12 + i]) % range) - Unit::ONE);
+                Push(out, cursor ? table.Parameter(d, walk) : table.Parameter(d));
+            }
+        }
+    }
+
+    // BULK easing times from the raws, within a unit of [0, 1]
+    std::vector<Unit> EaseTimes(const Raw& in) {
+        std::vector<Unit> t;
+        for (int i = 0; i < BULK; ++i) {
+            t.push_back(U(static_cast<int32_t>(static_cast<uint32_t>(in[i]) % (3 * Unit::ONE)) - Unit::ONE));
+        }
+        return t;
+    }
+
+    // the BULK vectors of Vecs as three coordinate streams
+    void Soa(const Raw& in, std::vector<Unit>& x, std::vector<Unit>& y, std::vector<Unit>& z) {
+        for (const Vec3& v : Vecs(in, BULK)) {
+            x.push_back(v.x);
+            y.push_back(v.y);
+            z.push_back(v.z);
+        }
+    }
+
+    // alpha in [0, 1] from one raw input
+    float Alpha(int32_t raw) {
+        return static_cast<float>(raw & 0xFFFF) / 65535.0f;
+    }
+
+    void PushLerp(Outcome& out, const Raw& in, int count, const float* pad = nullptr) {
+        const float alpha = Alpha(in[6 * count]);
+        for (int i = 0; i < 3 * count; ++i) {
+            PushFloat(out, AsFloatLerp(U(in[i]), U(in[3 * count + i]), alpha));
+            if (pad && i % 3 == 2) {
+                PushFloat(out, *pad);
+            }
+        }
+    }
+
+    // domains, chosen so no operation overflows a signed int
+    int32_t Any(int32_t v) {
+        return v == INT32_MIN ? INT32_MAX : v;
+    }
+
+    int32_t Half(int32_t v) {
+        return v / 2;
+    }
+
+    int32_t Small(int32_t v) {
+        return v % (128 * Unit::ONE);
+    }
+
+    // independent integer model of operator*: round half up, then truncate toward zero
+    int32_t ModelMul(int32_t a, int32_t b) {
+        int64_t q = static_cast<int64_t>(a) * b + Unit::HALF;
+        int64_t t = q >= 0 ? (q >> 15) : -((-q) >> 15);
+        return static_cast<int32_t>(t);
+    }
+
+    // independent integer model of operator/: adds half the divisor toward its sign
+    int32_t ModelDiv(int32_t a, int32_t b) {
+        if (b == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        int64_t n = static_cast<int64_t>(a) * Unit::ONE + (b > 0 ? b / 2 : -(-static_cast<int64_t>(b) / 2));
+        uint64_t un = static_cast<uint64_t>(n < 0 ? -n : n);
+        uint64_t ub = static_cast<uint64_t>(b < 0 ? -static_cast<int64_t>(b) : b);
+        int64_t q = static_cast<int64_t>(un / ub);
+        return static_cast<int32_t>((n < 0) != (b < 0) ? -q : q);
+    }
+
+    const std::vector<Pair>& Pairs() {
+        static const std::vector<Pair> pairs = {
+            // scalar operators against integer models
+            { "unit.mul/model", 2, Any,
+                [](const Raw& in, Outcome& out) { Push(out, U(in[0]) * U(in[1])); },
+                [](const Raw& in, Outcome& out) { out.values.push_back(ModelMul(in[0], in[1])); } },
+            { "unit.div/model", 2, Any,
+                [](const Raw& in, Outcome& out) { Push(out, U(in[0]) / U(in[1])); },
+                [](const Raw& in, Outcome& out) { out.values.push_back(ModelDiv(in[0], in[1])); } },
+            { "unit.add_sub/model", 2, Half,
+                [](const Raw& in, Outcome& out) { Push(out, U(in[0]) + U(in[1])); Push(out, U(in[0]) - U(in[1])); Push(out, -U(in[0])); },
+                [](const Raw& in, Outcome& out) { out.values = { int64_t(in[0]) + in[1], int64_t(in[0]) - in[1], -int64_t(in[0]) }; } },
+            { "unit.compound/binary", 2, Half,
+                [](const Raw& in, Outcome& out) {
+                    Unit a = U(in[0]);
+                    a += U(in[1]); Push(out, a);
+                    a -= U(in[1]); Push(out, a);
+                    a *= U(in[1]); Push(out, a);
+                    a /= U(in[1]); Push(out, a);
+                },
+                [](const Raw& in, Outcome& out) {
+                    Unit a = U(in[0]) + U(in[1]); Push(out, a);
+                    a = a - U(in[1]); Push(out, a);
+                    a = a * U(in[1]); Push(out, a);
+                    a = a / U(in[1]); Push(out, a);
+                } },
+            // Vec3 operators against per-lane Unit operators
+            { "vec3.add/lanes", 6, Half,
+                [](const Raw& in, Outcome& out) { Push(out, V(in, 0) + V(in, 3)); Push(out, V(in, 0) - V(in, 3)); },
+                [](const Raw& in, Outcome& out) {
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) + U(in[k + 3]));
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) - U(in[k + 3]));
+                } },
+            { "vec3.mul_div/lanes", 6, Any,
+                [](const Raw& in, Outcome& out) { Push(out, V(in, 0) * V(in, 3)); Push(out, V(in, 0) / V(in, 3)); },
+                [](const Raw& in, Outcome& out) {
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) * U(in[k + 3]));
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) / U(in[k + 3]));
+                } },
+            { "vec3.scalar/lanes", 4, Half,
+                [](const Raw& in, Outcome& out) {
+                    Vec3 v = V(in, 0);
+                    Push(out, v + U(in[3])); Push(out, v - U(in[3])); Push(out, v * U(in[3])); Push(out, v / U(in[3]));
+                },
+                [](const Raw& in, Outcome& out) {
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) + U(in[3]));
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) - U(in[3]));
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) * U(in[3]));
+                    for (int k = 0; k < 3; ++k) Push(out, U(in[k]) / U(in[3]));
+                } },
+            { "vec3.dot/lanes", 6, Small,
+                [](const Raw& in, Outcome& out) { Push(out, V(in, 0).Dot(V(in, 3))); },
+                [](const Raw& in, Outcome& out) {
+                    Unit sum = 0;
+                    for (int k = 0; k < 3; ++k) sum += U(in[k]) * U(in[k + 3]);
+                    Push(out, sum);
+                } },
+            { "vec3.asfloat/lanes", 3, Any,
+                [](const Raw& in, Outcome& out) { Vec3F f = V(in, 0).AsFloat(); PushFloat(out, f.x); PushFloat(out, f.y); PushFloat(out, f.z); },
+                [](const Raw& in, Outcome& out) { for (int k = 0; k < 3; ++k) PushFloat(out, U(in[k]).AsFloat()); } },
+            // bulk conversions against per-element AsFloat
+            { "convert.units/scalar", 11, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Unit> u;
+                    for (int32_t r : in) u.push_back(U(r));
+                    std::vector<float> f(u.size());
+                    AsFloat(u.data(), u.size(), f.data());
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { for (int32_t r : in) PushFloat(out, U(r).AsFloat()); } },
+            { "convert.interleaved/scalar", 3 * BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> v = Vecs(in, BULK);
+                    std::vector<float> f(3 * BULK);
+                    AsFloatInterleaved(v.data(), v.size(), f.data());
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { PushAsFloat(out, in, BULK); } },
+            { "convert.padded/scalar", 3 * BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> v = Vecs(in, BULK);
+                    std::vector<float> f(4 * BULK);
+                    AsFloatPadded(v.data(), v.size(), f.data(), 1.0f);
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { const float w = 1.0f; PushAsFloat(out, in, BULK, &w); } },
+            { "convert.soa/scalar", 3 * BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> v = Vecs(in, BULK);
+                    std::vector<float> x(BULK), y(BULK), z(BULK);
+                    AsFloatSoA(v.data(), v.size(), x.data(), y.data(), z.data());
+                    for (int i = 0; i < BULK; ++i) { PushFloat(out, x[i]); PushFloat(out, y[i]); PushFloat(out, z[i]); }
+                },
+                [](const Raw& in, Outcome& out) { PushAsFloat(out, in, BULK); } },
+            { "convert.streams/scalar", 3 * BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> v = Vecs(in, BULK);
+                    std::vector<Unit> x, y, z;
+                    for (const Vec3& p : v) { x.push_back(p.x); y.push_back(p.y); z.push_back(p.z); }
+                    std::vector<float> f(3 * BULK);
+                    AsFloatInterleaved(x.data(), y.data(), z.data(), v.size(), f.data());
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { PushAsFloat(out, in, BULK); } },
+            { "convert.lerp/scalar", 6 * BULK + 1, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> p = Vecs(in, BULK);
+                    std::vector<Vec3> c = Vecs(Raw(in.begin() + 3 * BULK, in.end()), BULK);
+                    std::vector<float> f(3 * BULK);
+                    AsFloatLerpInterleaved(p.data(), c.data(), BULK, Alpha(in[6 * BULK]), f.data());
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { PushLerp(out, in, BULK); } },
+            { "convert.lerp_pad/scalar", 6 * BULK + 1, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Vec3> p = Vecs(in, BULK);
+                    std::vector<Vec3> c = Vecs(Raw(in.begin() + 3 * BULK, in.end()), BULK);
+                    std::vector<float> f(4 * BULK);
+                    AsFloatLerpPadded(p.data(), c.data(), BULK, Alpha(in[6 * BULK]), f.data(), 1.0f);
+                    PushFloats(out, f);
+                },
+                [](const Raw& in, Outcome& out) { const float w = 1.0f; PushLerp(out, in, BULK, &w); } },
+            // SoA noise samplers against the scalar functions, 2D then 3D, seed from the last raw
+            { "noise.perlin/scalar", 3 * BULK + 1, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Unit> x, y, z, n2(BULK), n3(BULK);
+                    Soa(in, x, y, z);
+                    const uint32_t seed = static_cast<uint32_t>(in[3 * BULK]);
+                    Perlin(x.data(), y.data(), BULK, n2.data(), seed);
+                    Perlin(x.data(), y.data(), z.data(), BULK, n3.data(), seed);
+                    for (const Unit& u : n2) Push(out, u);
+                    for (const Unit& u : n3) Push(out, u);
+                },
+                [](const Raw& in, Outcome& out) {
+                    const uint32_t seed = static_cast<uint32_t>(in[3 * BULK]);
+                    for (const Vec3& v : Vecs(in, BULK)) Push(out, Perlin(v.x, v.y, seed));
+                    for (const Vec3& v : Vecs(in, BULK)) Push(out, Perlin(v, seed));
+                } },
+            { "noise.simplex/scalar", 3 * BULK + 1, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Unit> x, y, z, n2(BULK), n3(BULK);
+                    Soa(in, x, y, z);
+                    const uint32_t seed = static_cast<uint32_t>(in[3 * BULK]);
+                    Simplex(x.data(), y.data(), BULK, n2.data(), seed);
+                    Simplex(x.data(), y.data(), z.data(), BULK, n3.data(), seed);
+                    for (const Unit& u : n2) Push(out, u);
+                    for (const Unit& u : n3) Push(out, u);
+                },
+                [](const Raw& in, Outcome& out) {
+                    const uint32_t seed = static_cast<uint32_t>(in[3 * BULK]);
+                    for (const Vec3& v : Vecs(in, BULK)) Push(out, Simplex(v.x, v.y, seed));
+                    for (const Vec3& v : Vecs(in, BULK)) Push(out, Simplex(v, seed));
+                } },
+            // a one-channel clip sampled in sequence with a cursor against one-off track samples
+            { "keyframes.cursor/search", 4 * KEYS + BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Keyframe> keys = Keys(in);
+                    std::vector<Unit> times, values, ins, outs;
+                    for (const Keyframe& k : keys) {
+                        times.push_back(k.time);
+                        values.push_back(k.value);
+                        ins.push_back(k.in);
+                        outs.push_back(k.out);
+                    }
+                    for (Interpolation mode : { Interpolation::Linear, Interpolation::Hermite, Interpolation::Bezier }) {
+                        KeyClip clip(times.data(), KEYS, 1, mode, values.data(), ins.data(), outs.data());
+                        TrackCursor cursor;
+                        for (int i = 0; i < BULK; ++i) {
+                            Unit v;
+                            clip.Sample(KeyTime(in, i), cursor, &v);
+                            Push(out, v);
+                        }
+                    }
+                },
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Keyframe> keys = Keys(in);
+                    for (Interpolation mode : { Interpolation::Linear, Interpolation::Hermite, Interpolation::Bezier }) {
+                        for (int i = 0; i < BULK; ++i) Push(out, KeyTrack(keys.data(), KEYS, mode).Sample(KeyTime(in, i)));
+                    }
+                } },
+            // arc-length lookups walked with a cursor against one-off searches, on splines within 256 units
+            { "arclength.cursor/search", 12 + BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    ArcLengths(in, out, true);
+                },
+                [](const Raw& in, Outcome& out) {
+                    ArcLengths(in, out, false);
+                } },
+            // every easing over BULK times within a unit of [0, 1], then a tween over the same times
+            { "easing.batch/scalar", BULK, Any,
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Unit> t = EaseTimes(in), eased(BULK);
+                    for (int e = 0; e <= static_cast<int>(Easing::BounceInOut); ++e) {
+                        Ease(static_cast<Easing>(e), t.data(), BULK, eased.data());
+                        for (const Unit& u : eased) Push(out, u);
+                    }
+                    Tween(U(in[0]), U(in[1]), Unit(1), Easing::ElasticOut).Sample(t.data(), BULK, t.data());
+                    for (const Unit& u : t) Push(out, u);
+                },
+                [](const Raw& in, Outcome& out) {
+                    std::vector<Unit> t = EaseTimes(in);
+                    for (int e = 0; e <= static_cast<int>(Easing::BounceInOut); ++e) {
+                        for (const Unit& u : t) Push(out, Ease(static_cast<Easing>(e), u));
+                    }
+                    for (const Unit& u : t) Push(out, Tween(U(in[0]), U(in[1]), Unit(1), Easing::ElasticOut).Sample(u));
+                } },
+        };
+        return pairs;
+    }
+
+    Outcome Run(void (*fn)(const Raw&, Outcome&), const Raw& in) {
+        Outcome out;
+        try {
+            fn(in, out);
+        }
+        catch (const std::runtime_error&) {
+            out.threw = true;
+            out.values.clear();
+        }
+        return out;
+    }
+
+    Raw Apply(const Pair& p, Raw in) {
+        for (int32_t& v : in) {
+            v = p.domain(v);
+        }
+        return in;
+    }
+
+    bool Matches(const Pair& p, const Raw& in) {
+        return Run(p.fast, in) == Run(p.reference, in);
+    }
+
+    const std::vector<int32_t>& EdgeValues() {
+        static std::vector<int32_t> edges;
+        if (edges.empty()) {
+            const int32_t base[] = { 0, 1, Unit::HALF, Unit::ONE - 1, Unit::ONE, Unit::ONE + 1, 2 * Unit::ONE,
+                65535 * Unit::ONE, INT32_MAX, INT32_MAX - 1 };
+            for (int32_t v : base) {
+                edges.push_back(v);
+                edges.push_back(-v);
+            }
+            for (int k = 0; k < 31; ++k) {
+                edges.push_back(int32_t(1) << k);
+                edges.push_back(-(int32_t(1) << k));
+            }
+            edges.push_back(INT32_MIN);
+        }
+        return edges;
+    }
+
+    uint64_t SplitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // half edge values (sometimes nudged by one LSB), half random values at random magnitudes
+    int32_t EdgeHeavy(uint64_t& rng) {
+        uint64_t r = SplitMix(rng);
+        const std::vector<int32_t>& edges = EdgeValues();
+        if (r & 1) {
+            int32_t v = edges[(r >> 8) % edges.size()];
+            int nudge = static_cast<int>((r >> 40) % 3) - 1;
+            return (nudge > 0 && v < INT32_MAX) || (nudge < 0 && v > INT32_MIN) ? v + nudge : v;
+        }
+        int shift = static_cast<int>((r >> 1) & 31);
+        int32_t v = static_cast<int32_t>(static_cast<uint32_t>(r >> 32) >> shift);
+        return (r & 64) ? -v : v;
+    }
+
+    int64_t Magnitude(int32_t v) {
+        return v < 0 ? -int64_t(v) : int64_t(v);
+    }
+
+    // greedy shrinking: replace each operand with a simpler value while the mismatch persists
+    Raw Minimize(const Pair& p, Raw in) {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (size_t k = 0; k < in.size(); ++k) {
+                const int32_t candidates[] = { 0, 1, -1, Unit::ONE, -Unit::ONE, in[k] / 2, in[k] / Unit::ONE * Unit::ONE,
+                    in[k] > 0 ? in[k] - 1 : in[k] + 1 };
+                for (int32_t c : candidates) {
+                    int32_t v = p.domain(c);
+                    if (Magnitude(v) >= Magnitude(in[k])) {
+                        continue;
+                    }
+                    Raw trial = in;
+                    trial[k] = v;
+                    if (!Matches(p, trial)) {
+                        in = trial;
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+        return in;
+    }
+
+    void PrintOutcome(const char* label, const Outcome& o) {
+        std::fprintf(stderr, "  %s:", label);
+        if (o.threw) {
+            std::fprintf(stderr, " throw");
+        }
+        for (int64_t v : o.values) {
+            std::fprintf(stderr, " %lld", static_cast<long long>(v));
+        }
+        std::fprintf(stderr, "\n");
+    }
+
+    void Report(const Pair& p, const Raw& original) {
+        Raw in = Minimize(p, original);
+        std::fprintf(stderr, "mismatch in %s\n  reproduce: --repro=%s:", p.name, p.name);
+        for (size_t k = 0; k < in.size(); ++k) {
+            std::fprintf(stderr, "%s%d", k ? "," : "", in[k]);
+        }
+        std::fprintf(stderr, "\n");
+        PrintOutcome("fast", Run(p.fast, in));
+        PrintOutcome("reference", Run(p.reference, in));
+    }
+
+    // stable per-pair seed (std::hash differs between standard libraries)
+    uint64_t NameHash(const char* name) {
+        uint64_t h = 0xCBF29CE484222325ull;
+        for (; *name; ++name) {
+            h = (h ^ static_cast<unsigned char>(*name)) * 0x100000001B3ull;
+        }
+        return h;
+    }
+
+    const Pair* Find(const std::string& name) {
+        for (const Pair& p : Pairs()) {
+            if (name == p.name) {
+                return &p;
+            }
+        }
+        return nullptr;
+    }
+}
+
+#if defined(GEKKO_LIBFUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 1) {
+        return 0;
+    }
+    const Pair& p = Pairs()[data[0] % Pairs().size()];
+    Raw in(p.arity, 0);
+    for (int k = 0; k < p.arity && 1 + 4 * (k + 1) <= size; ++k) {
+        uint32_t bits;
+        std::memcpy(&bits, data + 1 + 4 * k, sizeof(bits));
+        in[k] = static_cast<int32_t>(bits);
+    }
+    in = Apply(p, in);
+    if (!Matches(p, in)) {
+        Report(p, in);
+        std::abort();
+    }
+    return 0;
+}
+
+#else
+
+int main(int argc, char** argv) {
+    uint64_t iterations = 1000000;
+    uint64_t seed = 0x46757A7A;
+    std::string only;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--iterations=", 13) == 0) {
+            iterations = std::strtoull(arg + 13, nullptr, 10);
+        }
+        else if (std::strncmp(arg, "--seed=", 7) == 0) {
+            seed = std::strtoull(arg + 7, nullptr, 0);
+        }
+        else if (std::strncmp(arg, "--pair=", 7) == 0) {
+            only = arg + 7;
+        }
+        else if (std::strncmp(arg, "--repro=", 8) == 0) {
+            std::string spec = arg + 8;
+            size_t colon = spec.find(':');
+            const Pair* p = Find(spec.substr(0, colon));
+            if (!p || colon == std::string::npos) {
+                std::fprintf(stderr, "bad --repro, expected name:a,b,...\n");
+                return 2;
+            }
+            Raw in;
+            for (size_t pos = colon + 1; pos <= spec.size();) {
+                size_t comma = std::min(spec.find(',', pos), spec.size());
+                in.push_back(static_cast<int32_t>(std::strtol(spec.c_str() + pos, nullptr, 10)));
+                pos = comma + 1;
+            }
+            in.resize(p->arity, 0);
+            if (!Matches(*p, in)) {
+                Report(*p, in);
+                return 1;
+            }
+            std::printf("%s matches\n", p->name);
+            return 0;
+        }
+        else {
+            std::fprintf(stderr, "usage: %s [--iterations=N] [--seed=N] [--pair=name] [--repro=name:a,b,...]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int failures = 0;
+    for (const Pair& p : Pairs()) {
+        if (!only.empty() && only != p.name) {
+            continue;
+        }
+        uint64_t rng = seed ^ NameHash(p.name);
+        bool ok = true;
+        for (uint64_t i = 0; i < iterations && ok; ++i) {
+            Raw in(p.arity);
+            for (int32_t& v : in) {
+                v = EdgeHeavy(rng);
+            }
+            in = Apply(p, in);
+            if (!Matches(p, in)) {
+                Report(p, in);
+                ok = false;
+                failures++;
+            }
+        }
+        std::printf("%-24s %s\n", p.name, ok ? "ok" : "MISMATCH");
+    }
+    return failures ? 1 : 0;
+}
+
+#endif
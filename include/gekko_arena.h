@@ -0,0 +1,264 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Per-frame linear arena for transient math memory (pair lists, contact arrays, Vec3 streams).
+//
+// One block is allocated up front, allocations bump an offset and nothing is freed individually:
+// Mark/Rewind (or ArenaScope) release everything allocated since the mark, Reset releases it all,
+// typically once per tick. Destructors are never run, so only trivially destructible types can
+// live in the arena. Running out of space reports GEKKO_MATH_ERROR and returns nullptr.
+//
+//     FrameArena& arena = ThreadArena();
+//     arena.Reset();                                   // start of tick
+//     ArenaArray<Vec3> points(arena, count);
+//     std::vector<uint32_t, ArenaAllocator<uint32_t>> pairs{ ArenaAllocator<uint32_t>(arena) };
+#ifndef GEKKO_FRAME_ARENA_BYTES
+#define GEKKO_FRAME_ARENA_BYTES (1u << 20)
+#endif
+
+namespace Gekko::Math {
+
+    class FrameArena {
+    public:
+        static constexpr size_t BLOCK_ALIGN = 64;
+
+        struct Marker {
+            size_t offset;
+        };
+
+        explicit FrameArena(size_t capacity)
+            : _base(static_cast<unsigned char*>(::operator new(capacity, std::align_val_t(BLOCK_ALIGN)))),
+              _capacity(capacity) {}
+
+        ~FrameArena() {
+            ::operator delete(_base, std::align_val_t(BLOCK_ALIGN));
+        }
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // nullptr when the block has no room left; 'align' must be a power of two
+        void* TryAllocate(size_t size, size_t align = alignof(std::max_align_t)) {
+            if (align == 0 || (align & (align - 1)) != 0) {
+                GEKKO_MATH_ERROR("arena alignment must be a power of two");
+                return nullptr;
+            }
+            const uintptr_t base = reinterpret_cast<uintptr_t>(_base);
+            const uintptr_t at = (base + _offset + (align - 1)) & ~static_cast<uintptr_t>(align - 1);
+            const size_t end = static_cast<size_t>(at - base) + size;
+            if (end > _capacity || end < _offset) {
+                return nullptr;
+            }
+            _offset = end;
+            _high_water = _offset > _high_water ? _offset : _high_water;
+            return reinterpret_cast<void*>(at);
+        }
+
+        void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+            void* p = TryAllocate(size, align);
+            if (!p) {
+                GEKKO_MATH_ERROR("frame arena exhausted");
+            }
+            return p;
+        }
+
+        // uninitialized storage for 'count' objects
+        template <typename T>
+        T* AllocateArray(size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "arena memory is released without running destructors");
+            if (count > _capacity / sizeof(T)) {
+                GEKKO_MATH_ERROR("frame arena exhausted");
+                return nullptr;
+            }
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        Marker Mark() const {
+            return Marker{ _offset };
+        }
+
+        void Rewind(Marker m) {
+            _offset = m.offset;
+        }
+
+        void Reset() {
+            _offset = 0;
+        }
+
+        size_t Used() const {
+            return _offset;
+        }
+
+        size_t Capacity() const {
+            return _capacity;
+        }
+
+        // largest Used() since construction, for sizing the block
+        size_t HighWater() const {
+            return _high_water;
+        }
+
+        bool Owns(const void* p) const {
+            const unsigned char* c = static_cast<const unsigned char*>(p);
+            return c >= _base && c < _base + _capacity;
+        }
+
+    private:
+        unsigned char* _base;
+        size_t _capacity;
+        size_t _offset = 0;
+        size_t _high_water = 0;
+    };
+
+    // arena of the calling thread, GEKKO_FRAME_ARENA_BYTES large
+    inline FrameArena& ThreadArena() {
+        thread_local FrameArena arena(GEKKO_FRAME_ARENA_BYTES);
+        return arena;
+    }
+
+    // rewinds the arena to where it was when the scope was entered
+    class ArenaScope {
+    public:
+        explicit ArenaScope(FrameArena& arena) : _arena(arena), _mark(arena.Mark()) {}
+
+        ~ArenaScope() {
+            _arena.Rewind(_mark);
+        }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+        FrameArena& _arena;
+        FrameArena::Marker _mark;
+    };
+
+    // fixed-capacity array in the arena, the capacity is reserved on construction
+    template <typename T>
+    class ArenaArray {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is released without running destructors");
+
+    public:
+        ArenaArray(FrameArena& arena, size_t capacity)
+            : _data(arena.AllocateArray<T>(capacity)), _capacity(_data ? capacity : 0) {}
+
+        void PushBack(const T& value) {
+            if (_size == _capacity) {
+                GEKKO_MATH_ERROR("arena array is full");
+                return;
+            }
+            _data[_size++] = value;
+        }
+
+        void Clear() {
+            _size = 0;
+        }
+
+        // grows or shrinks within the capacity, new elements are left uninitialized
+        void Resize(size_t size) {
+            if (size > _capacity) {
+                GEKKO_MATH_ERROR("arena array is full");
+                return;
+            }
+            _size = size;
+        }
+
+        T& operator[](size_t i) {
+            return _data[i];
+        }
+
+        const T& operator[](size_t i) const {
+            return _data[i];
+        }
+
+        T* Data() {
+            return _data;
+        }
+
+        const T* Data() const {
+            return _data;
+        }
+
+        size_t Size() const {
+            return _size;
+        }
+
+        size_t Capacity() const {
+            return _capacity;
+        }
+
+        bool Empty() const {
+            return _size == 0;
+        }
+
+        T* begin() {
+            return _data;
+        }
+
+        T* end() {
+            return _data + _size;
+        }
+
+        const T* begin() const {
+            return _data;
+        }
+
+        const T* end() const {
+            return _data + _size;
+        }
+
+    private:
+        T* _data;
+        size_t _capacity;
+        size_t _size = 0;
+    };
+
+    // standard allocator over a FrameArena, deallocate is a no-op; for containers that must grow,
+    // every growth leaves the old storage in the arena until the next Reset
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena& arena) : _arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.Arena()) {}
+
+        T* allocate(size_t count) {
+            if (count > SIZE_MAX / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            T* p = static_cast<T*>(_arena->TryAllocate(sizeof(T) * count, alignof(T)));
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        void deallocate(T*, size_t) {}
+
+        FrameArena* Arena() const {
+            return _arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const {
+            return _arena == other.Arena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const {
+            return _arena != other.Arena();
+        }
+
+    private:
+        FrameArena* _arena;
+    };
+}
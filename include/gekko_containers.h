@@ -0,0 +1,280 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstdint>
+
+// Fixed-capacity containers with inline storage, for shapes that hold a handful of points
+// (capsules, simplices, contact manifolds) and for pooled objects such as broadphase proxies.
+//
+// Neither container owns heap memory, so for trivially copyable T the whole container is
+// trivially copyable and a rollback snapshot is a plain copy or memcpy. Removed slots are reset
+// to T{}, so for T without padding two containers with the same history are also byte-identical
+// and can be hashed or compared as raw memory. Exceeding the capacity reports GEKKO_MATH_ERROR.
+namespace Gekko::Math {
+
+    template <typename T, uint32_t N>
+    class SmallVec {
+        static_assert(N > 0, "SmallVec needs a capacity");
+
+    public:
+        SmallVec() = default;
+
+        void PushBack(const T& value) {
+            if (_size == N) {
+                GEKKO_MATH_ERROR("SmallVec is full");
+                return;
+            }
+            _items[_size++] = value;
+        }
+
+        void PopBack() {
+            if (_size > 0) {
+                _items[--_size] = T{};
+            }
+        }
+
+        // moves the last element into slot i, does not keep the order
+        void EraseSwap(uint32_t i) {
+            if (i >= _size) {
+                GEKKO_MATH_ERROR("SmallVec index out of range");
+                return;
+            }
+            _items[i] = _items[_size - 1];
+            PopBack();
+        }
+
+        void Clear() {
+            while (_size > 0) {
+                PopBack();
+            }
+        }
+
+        // new elements are T{}
+        void Resize(uint32_t size) {
+            if (size > N) {
+                GEKKO_MATH_ERROR("SmallVec is full");
+                return;
+            }
+            while (_size > size) {
+                PopBack();
+            }
+            _size = size;
+        }
+
+        T& operator[](uint32_t i) {
+            return _items[i];
+        }
+
+        const T& operator[](uint32_t i) const {
+            return _items[i];
+        }
+
+        T& Back() {
+            if (_size == 0) {
+                GEKKO_MATH_ERROR("SmallVec is empty");
+                return _items[0];
+            }
+            return _items[_size - 1];
+        }
+
+        const T& Back() const {
+            if (_size == 0) {
+                GEKKO_MATH_ERROR("SmallVec is empty");
+                return _items[0];
+            }
+            return _items[_size - 1];
+        }
+
+        T* Data() {
+            return _items;
+        }
+
+        const T* Data() const {
+            return _items;
+        }
+
+        uint32_t Size() const {
+            return _size;
+        }
+
+        static constexpr uint32_t Capacity() {
+            return N;
+        }
+
+        bool Empty() const {
+            return _size == 0;
+        }
+
+        bool Full() const {
+            return _size == N;
+        }
+
+        T* begin() {
+            return _items;
+        }
+
+        T* end() {
+            return _items + _size;
+        }
+
+        const T* begin() const {
+            return _items;
+        }
+
+        const T* end() const {
+            return _items + _size;
+        }
+
+        bool operator==(const SmallVec& other) const {
+            if (_size != other._size) {
+                return false;
+            }
+            for (uint32_t i = 0; i < _size; ++i) {
+                if (!(_items[i] == other._items[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const SmallVec& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        T _items[N] = {};
+        uint32_t _size = 0;
+    };
+
+    // Typed object pool with stable indices. A handle carries the slot index and the generation
+    // of the slot, so handles to destroyed objects are detected even after the slot is reused.
+    // The generation is odd while the slot is alive. Free slots are reused last-freed-first,
+    // which makes the index sequence deterministic.
+    template <typename T, uint32_t Capacity>
+    class Pool {
+        static_assert(Capacity > 0 && Capacity < 0xFFFFFFFFu, "Pool capacity out of range");
+
+    public:
+        static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+        struct Handle {
+            uint32_t index = INVALID;
+            uint32_t generation = 0;
+
+            bool operator==(const Handle& other) const {
+                return index == other.index && generation == other.generation;
+            }
+
+            bool operator!=(const Handle& other) const {
+                return !(*this == other);
+            }
+        };
+
+        Pool() {
+            Clear();
+        }
+
+        // invalid handle when the pool is full
+        Handle Create(const T& value = T{}) {
+            if (_free_head == INVALID) {
+                GEKKO_MATH_ERROR("Pool is full");
+                return Handle{};
+            }
+            uint32_t index = _free_head;
+            _free_head = _next_free[index];
+            _next_free[index] = INVALID;
+            _generation[index]++;
+            _items[index] = value;
+            _count++;
+            return Handle{ index, _generation[index] };
+        }
+
+        bool Destroy(Handle h) {
+            if (!Valid(h)) {
+                return false;
+            }
+            _items[h.index] = T{};
+            _generation[h.index]++;
+            _next_free[h.index] = _free_head;
+            _free_head = h.index;
+            _count--;
+            return true;
+        }
+
+        bool Valid(Handle h) const {
+            return h.index < Capacity && (h.generation & 1) && _generation[h.index] == h.generation;
+        }
+
+        // nullptr for stale handles
+        T* Get(Handle h) {
+            return Valid(h) ? &_items[h.index] : nullptr;
+        }
+
+        const T* Get(Handle h) const {
+            return Valid(h) ? &_items[h.index] : nullptr;
+        }
+
+        // unchecked access by slot index
+        T& operator[](uint32_t index) {
+            return _items[index];
+        }
+
+        const T& operator[](uint32_t index) const {
+            return _items[index];
+        }
+
+        bool Alive(uint32_t index) const {
+            return index < Capacity && (_generation[index] & 1);
+        }
+
+        Handle HandleAt(uint32_t index) const {
+            return Alive(index) ? Handle{ index, _generation[index] } : Handle{};
+        }
+
+        // live objects in index order: f(index, object)
+        template <typename F>
+        void ForEach(F&& f) {
+            for (uint32_t i = 0; i < Capacity; ++i) {
+                if (_generation[i] & 1) {
+                    f(i, _items[i]);
+                }
+            }
+        }
+
+        template <typename F>
+        void ForEach(F&& f) const {
+            for (uint32_t i = 0; i < Capacity; ++i) {
+                if (_generation[i] & 1) {
+                    f(i, _items[i]);
+                }
+            }
+        }
+
+        // destroys everything and restarts the generations, equal to a new pool
+        void Clear() {
+            for (uint32_t i = 0; i < Capacity; ++i) {
+                _items[i] = T{};
+                _generation[i] = 0;
+                _next_free[i] = i + 1 < Capacity ? i + 1 : INVALID;
+            }
+            _free_head = 0;
+            _count = 0;
+        }
+
+        uint32_t Size() const {
+            return _count;
+        }
+
+        static constexpr uint32_t MaxSize() {
+            return Capacity;
+        }
+
+    private:
+        T _items[Capacity];
+        uint32_t _generation[Capacity];
+        uint32_t _next_free[Capacity];
+        uint32_t _free_head;
+        uint32_t _count;
+    };
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Easing curves on Unit for gameplay timings such as dash speed and knockback falloff, identical on
+// every peer.
+//
+// Every curve maps t in [0, 1] to 0 at t = 0 and exactly 1 at t = 1; t outside is clamped. Each
+// family is defined by its In curve, Out is the In curve mirrored (1 - In(1 - t)) and InOut runs In
+// over each half at double speed, the second half mirrored, so InOut passes exactly 1/2 at t = 1/2.
+//
+//     Unit k = Ease(Easing::CubicOut, t);
+//     Ease(Easing::ElasticOut, ts, count, out);                 // one dispatch for the whole array
+//     Tween dash(Unit(0), Unit(12), Unit(20), Easing::QuadOut);  // from, to, duration in ticks
+//     Unit x = dash.Sample(elapsed);
+//
+// The polynomial families (quad to quint, back, bounce) are rounded 64-bit Horner steps. Sine,
+// expo and elastic read two 257-entry quarter-wave and 2^x tables with linear interpolation, and
+// circ uses an integer square root. All of them stay within 2 LSB of the float formulas.
+namespace Gekko::Math {
+
+    enum class Easing : uint8_t {
+        Linear,
+        QuadIn, QuadOut, QuadInOut,
+        CubicIn, CubicOut, CubicInOut,
+        QuartIn, QuartOut, QuartInOut,
+        QuintIn, QuintOut, QuintInOut,
+        SineIn, SineOut, SineInOut,
+        ExpoIn, ExpoOut, ExpoInOut,
+        CircIn, CircOut, CircInOut,
+        BackIn, BackOut, BackInOut,
+        ElasticIn, ElasticOut, ElasticInOut,
+        BounceIn, BounceOut, BounceInOut,
+    };
+
+    namespace Detail {
+        // sin(i / 256 * pi / 2) in Q15
+        inline constexpr int32_t EASE_SIN[257] = {
+            0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2411, 2611, 2811, 3012,
+            3212, 3412, 3612, 3812, 4011, 4211, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+            6393, 6590, 6787, 6983, 7180, 7376, 7571, 7767, 7962, 8157, 8351, 8546, 8740, 8933, 9127, 9319,
+            9512, 9704, 9896, 10088, 10279, 10469, 10660, 10850, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12354,
+            12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828, 14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269,
+            15447, 15624, 15800, 15976, 16151, 16326, 16500, 16673, 16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+            18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358, 19520, 19681, 19841, 20001, 20160, 20318, 20475, 20632,
+            20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856, 22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028,
+            23170, 23312, 23453, 23593, 23732, 23870, 24008, 24144, 24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+            25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199, 26320, 26439, 26557, 26674, 26791, 26906, 27020, 27133,
+            27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002, 28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803,
+            28899, 28993, 29086, 29178, 29269, 29359, 29448, 29535, 29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+            30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784, 30853, 30920, 30986, 31050, 31114, 31177, 31238, 31298,
+            31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737, 31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099,
+            32138, 32177, 32214, 32251, 32286, 32319, 32352, 32383, 32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+            32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718, 32729, 32738, 32746, 32753, 32758, 32762, 32766, 32767,
+            32768,
+        };
+
+        // 2^(i / 256) in Q15
+        inline constexpr int32_t EASE_EXP2[257] = {
+            32768, 32857, 32946, 33035, 33125, 33215, 33305, 33395, 33486, 33576, 33667, 33759, 33850, 33942, 34034, 34126,
+            34219, 34312, 34405, 34498, 34591, 34685, 34779, 34874, 34968, 35063, 35158, 35253, 35349, 35445, 35541, 35637,
+            35734, 35831, 35928, 36025, 36123, 36221, 36319, 36417, 36516, 36615, 36715, 36814, 36914, 37014, 37114, 37215,
+            37316, 37417, 37518, 37620, 37722, 37824, 37927, 38030, 38133, 38236, 38340, 38444, 38548, 38653, 38757, 38863,
+            38968, 39074, 39180, 39286, 39392, 39499, 39606, 39714, 39821, 39929, 40037, 40146, 40255, 40364, 40473, 40583,
+            40693, 40804, 40914, 41025, 41136, 41248, 41360, 41472, 41584, 41697, 41810, 41923, 42037, 42151, 42265, 42380,
+            42495, 42610, 42726, 42841, 42958, 43074, 43191, 43308, 43425, 43543, 43661, 43780, 43898, 44017, 44137, 44256,
+            44376, 44497, 44617, 44738, 44859, 44981, 45103, 45225, 45348, 45471, 45594, 45718, 45842, 45966, 46091, 46216,
+            46341, 46467, 46593, 46719, 46846, 46973, 47100, 47228, 47356, 47484, 47613, 47742, 47871, 48001, 48131, 48262,
+            48393, 48524, 48655, 48787, 48920, 49052, 49185, 49319, 49452, 49586, 49721, 49856, 49991, 50126, 50262, 50399,
+            50535, 50672, 50810, 50947, 51085, 51224, 51363, 51502, 51642, 51782, 51922, 52063, 52204, 52346, 52488, 52630,
+            52773, 52916, 53059, 53203, 53347, 53492, 53637, 53782, 53928, 54074, 54221, 54368, 54515, 54663, 54811, 54960,
+            55109, 55258, 55408, 55558, 55709, 55860, 56012, 56163, 56316, 56468, 56622, 56775, 56929, 57083, 57238, 57393,
+            57549, 57705, 57861, 58018, 58176, 58333, 58491, 58650, 58809, 58968, 59128, 59289, 59449, 59611, 59772, 59934,
+            60097, 60260, 60423, 60587, 60751, 60916, 61081, 61247, 61413, 61579, 61746, 61914, 62081, 62250, 62419, 62588,
+            62757, 62928, 63098, 63269, 63441, 63613, 63785, 63958, 64132, 64306, 64480, 64655, 64830, 65006, 65182, 65359,
+            65536,
+        };
+
+        // a * b in Q15, rounded
+        inline int64_t EaseMul(int64_t a, int64_t b) {
+            return (a * b + Unit::ONE / 2) >> 15;
+        }
+
+        // table lookup at r in [0, ONE], interpolated between the 256 steps
+        inline int64_t EaseTable(const int32_t (&table)[257], int64_t r) {
+            const int64_t i = r >> 7, f = r & 127;
+            const int64_t a = table[i];
+            return f == 0 ? a : a + (((table[i + 1] - a) * f + 64) >> 7);
+        }
+
+        // sin of an angle where a quarter turn is ONE
+        inline int64_t EaseSin(int64_t angle) {
+            const int64_t a = angle & (4 * Unit::ONE - 1);
+            const int64_t quadrant = a >> 15, r = a & (Unit::ONE - 1);
+            const int64_t s = quadrant & 1 ? EaseTable(EASE_SIN, Unit::ONE - r) : EaseTable(EASE_SIN, r);
+            return quadrant & 2 ? -s : s;
+        }
+
+        // 2^x for x <= 0 in Q15
+        inline int64_t EaseExp2(int64_t x) {
+            const int64_t whole = x >> 15, m = EaseTable(EASE_EXP2, x & (Unit::ONE - 1));
+            const int64_t shift = -whole;
+            return shift == 0 ? m : (shift > 40 ? 0 : (m + (int64_t(1) << (shift - 1))) >> shift);
+        }
+
+        constexpr int64_t BACK_C1 = 55757;            // 1.70158
+        constexpr int64_t BOUNCE_N = 247808;          // 7.5625
+        constexpr int64_t ELASTIC_SHIFT = 352256;     // 10.75
+
+        // the bounce family is defined by its Out curve; the parabola offsets are Q20 so the
+        // steep squares do not magnify their rounding
+        inline int64_t BounceOut(int64_t u) {
+            int64_t d, c;
+            if (u < 11916) {
+                d = u << 5;
+                c = 0;
+            }
+            else if (u < 23831) {
+                d = (u << 5) - 571951;
+                c = 24576;
+            }
+            else if (u < 29789) {
+                d = (u << 5) - 857926;
+                c = 30720;
+            }
+            else {
+                d = (u << 5) - 1000913;
+                c = 32256;
+            }
+            return (((d * d >> 10) * BOUNCE_N + (int64_t(1) << 29)) >> 30) + c;
+        }
+
+        // the In curve of a family at u in [0, ONE], with In(0) = 0 and In(ONE) = ONE
+        struct QuadIn {
+            int64_t operator()(int64_t u) const {
+                return EaseMul(u, u);
+            }
+        };
+
+        struct CubicIn {
+            int64_t operator()(int64_t u) const {
+                return EaseMul(EaseMul(u, u), u);
+            }
+        };
+
+        struct QuartIn {
+            int64_t operator()(int64_t u) const {
+                const int64_t u2 = EaseMul(u, u);
+                return EaseMul(u2, u2);
+            }
+        };
+
+        struct QuintIn {
+            int64_t operator()(int64_t u) const {
+                const int64_t u2 = EaseMul(u, u);
+                return EaseMul(EaseMul(u2, u2), u);
+            }
+        };
+
+        // 1 - cos(u pi / 2)
+        struct SineIn {
+            int64_t operator()(int64_t u) const {
+                return Unit::ONE - EaseSin(u + Unit::ONE);
+            }
+        };
+
+        // 2^(10u - 10), 0 at u = 0
+        struct ExpoIn {
+            int64_t operator()(int64_t u) const {
+                return u == 0 ? 0 : EaseExp2(10 * u - 10 * int64_t(Unit::ONE));
+            }
+        };
+
+        // 1 - sqrt(1 - u^2)
+        struct CircIn {
+            int64_t operator()(int64_t u) const {
+                // 1 - u^2 exactly in Q30, so the root is the rounded Q15 result
+                const int64_t x = int64_t(Unit::ONE) * Unit::ONE - u * u;
+                const int64_t root = static_cast<int64_t>(ISqrt(static_cast<uint64_t>(x)));
+                return Unit::ONE - (x - root * root > root ? root + 1 : root);
+            }
+        };
+
+        // (c1 + 1) u^3 - c1 u^2, dipping below 0 first
+        struct BackIn {
+            int64_t operator()(int64_t u) const {
+                const int64_t u2 = EaseMul(u, u);
+                return EaseMul(EaseMul(BACK_C1 + Unit::ONE, u) - BACK_C1, u2);
+            }
+        };
+
+        // -2^(10u - 10) sin((10u - 10.75) 2 pi / 3)
+        struct ElasticIn {
+            int64_t operator()(int64_t u) const {
+                if (u == 0 || u == Unit::ONE) {
+                    return u;
+                }
+                // a third of a turn per unit is 4/3 quarter turns; whole turns keep the division positive
+                const int64_t turns = 4 * (10 * u - ELASTIC_SHIFT) + 12 * (4 * int64_t(Unit::ONE));
+                return -EaseMul(EaseExp2(10 * u - 10 * int64_t(Unit::ONE)), EaseSin((turns + 1) / 3));
+            }
+        };
+
+        struct BounceIn {
+            int64_t operator()(int64_t u) const {
+                return Unit::ONE - BounceOut(Unit::ONE - u);
+            }
+        };
+
+        // mode 0 is In, 1 Out and 2 InOut; u is clamped to [0, ONE]
+        template <typename In>
+        int64_t EaseMode(const In& in, int mode, int64_t u) {
+            if (u <= 0) {
+                return 0;
+            }
+            if (u >= Unit::ONE) {
+                return Unit::ONE;
+            }
+            switch (mode) {
+            case 0:
+                return in(u);
+            case 1:
+                return Unit::ONE - in(Unit::ONE - u);
+            default:
+                return u < Unit::HALF ? (in(2 * u) + 1) >> 1 : Unit::ONE - ((in(2 * (Unit::ONE - u)) + 1) >> 1);
+            }
+        }
+
+        template <typename In>
+        void EaseBatch(const In& in, int mode, const Unit* t, size_t count, Unit* out) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Unit::From(static_cast<int32_t>(EaseMode(in, mode, t[i].Raw())));
+            }
+        }
+
+        // calls f(in, mode) with the In curve and mode of any easing but Linear
+        template <typename F>
+        void EaseDispatch(Easing easing, F&& f) {
+            const int family = (static_cast<int>(easing) - 1) / 3, mode = (static_cast<int>(easing) - 1) % 3;
+            switch (family) {
+            case 0: f(QuadIn(), mode); break;
+            case 1: f(CubicIn(), mode); break;
+            case 2: f(QuartIn(), mode); break;
+            case 3: f(QuintIn(), mode); break;
+            case 4: f(SineIn(), mode); break;
+            case 5: f(ExpoIn(), mode); break;
+            case 6: f(CircIn(), mode); break;
+            case 7: f(BackIn(), mode); break;
+            case 8: f(ElasticIn(), mode); break;
+            default: f(BounceIn(), mode); break;
+            }
+        }
+    }
+
+    // eased t, with t clamped to [0, 1]
+    inline Unit Ease(Easing easing, Unit t) {
+        const int64_t u = t.Raw();
+        if (easing == Easing::Linear) {
+            return Unit::From(static_cast<int32_t>(u < 0 ? 0 : (u > Unit::ONE ? Unit::ONE : u)));
+        }
+        int64_t result = 0;
+        Detail::EaseDispatch(easing, [u, &result](const auto& in, int mode) { result = Detail::EaseMode(in, mode, u); });
+        return Unit::From(static_cast<int32_t>(result));
+    }
+
+    // out[i] = Ease(easing, t[i]), choosing the curve once for the whole array
+    inline void Ease(Easing easing, const Unit* t, size_t count, Unit* out) {
+        if (easing == Easing::Linear) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Ease(Easing::Linear, t[i]);
+            }
+            return;
+        }
+        Detail::EaseDispatch(easing, [t, count, out](const auto& in, int mode) { Detail::EaseBatch(in, mode, t, count, out); });
+    }
+
+    // a value eased from 'from' to 'to' over 'duration', e.g. in ticks
+    class Tween {
+    public:
+        Tween() = default;
+
+        Tween(Unit from, Unit to, Unit duration, Easing easing) : _from(from), _to(to), _duration(duration), _easing(easing) {
+            if (duration.Raw() <= 0) {
+                GEKKO_MATH_ERROR("Tween duration must be positive");
+                _duration = Unit::From(1);
+            }
+        }
+
+        Unit Duration() const {
+            return _duration;
+        }
+
+        Easing Mode() const {
+            return _easing;
+        }
+
+        // value after 'elapsed', holding 'from' before the start and 'to' after the end
+        Unit Sample(Unit elapsed) const {
+            return Value(Ease(_easing, Progress(elapsed)));
+        }
+
+        // out[i] = Sample(elapsed[i]); 'out' may alias 'elapsed'
+        void Sample(const Unit* elapsed, size_t count, Unit* out) const {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Progress(elapsed[i]);
+            }
+            Ease(_easing, out, count, out);
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Value(out[i]);
+            }
+        }
+
+    private:
+        // elapsed / duration in [0, ONE], rounded
+        Unit Progress(Unit elapsed) const {
+            const int64_t e = elapsed.Raw(), d = _duration.Raw();
+            if (e <= 0) {
+                return Unit(0);
+            }
+            if (e >= d) {
+                return Unit(1);
+            }
+            return Unit::From(static_cast<int32_t>(((e << 15) + d / 2) / d));
+        }
+
+        // from + (to - from) k, in 64 bits so the span may exceed the Unit range
+        Unit Value(Unit k) const {
+            const int64_t span = static_cast<int64_t>(_to.Raw()) - _from.Raw();
+            return Unit::From(static_cast<int32_t>(_from.Raw() + ((span * k.Raw() + Unit::ONE / 2) >> 15)));
+        }
+
+        Unit _from = Unit(0);
+        Unit _to = Unit(0);
+        Unit _duration = Unit(1);
+        Easing _easing = Easing::Linear;
+    };
+}
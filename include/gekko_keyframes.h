@@ -0,0 +1,272 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Keyframe curves for hitboxes and attachment points, sampled identically on every peer.
+//
+// A KeyTrack is a view over Keyframe{time, value, in, out} records (16 bytes each) with one
+// interpolation for the whole track: linear, cubic Hermite (in/out are slopes per unit of time)
+// or cubic Bezier (in/out are the control values before and after the key). Times must increase;
+// sampling clamps to the first and last key.
+//
+//     const Keyframe keys[] = { { Unit(0), Unit(0) }, { Unit(1), Unit(5) }, { Unit(2), Unit(3) } };
+//     KeyTrack track(keys, 3, Interpolation::Linear);
+//     TrackCursor cursor;                                  // per sampler, e.g. per hitbox
+//     Unit y = track.Sample(time, cursor);
+//
+// The cursor remembers the last segment, so sampling a track at advancing (or slightly rewound)
+// times costs a compare or two instead of a binary search; a jump falls back to the search. It is
+// only a hint: the result never depends on it, so it need not be part of a rollback snapshot.
+//
+// Every mode reduces a segment to four weights on (value0, out0, in1, value1) that are blended in
+// 64 bits and rounded once. A KeyClip holds many channels keyed at the same times (all the boxes of
+// one move, say): it locates the segment and computes the weights once per sample and then runs a
+// plain multiply-add loop over the channels, and each channel matches the equivalent KeyTrack.
+namespace Gekko::Math {
+
+    enum class Interpolation : uint8_t {
+        Linear,
+        Hermite,
+        Bezier,
+    };
+
+    // in and out are unused by linear tracks; {time, value} leaves them 0
+    struct Keyframe {
+        Unit time;
+        Unit value;
+        Unit in = Unit(0);
+        Unit out = Unit(0);
+    };
+
+    // the segment a track was last sampled in
+    struct TrackCursor {
+        uint32_t segment = 0;
+    };
+
+    namespace Detail {
+        // segment s in [0, count - 2] with time(s) <= t < time(s + 1), clamped at both ends;
+        // the hint and its neighbours are tried before the binary search
+        template <typename TimeAt>
+        uint32_t Locate(const TimeAt& time, uint32_t count, Unit t, uint32_t hint) {
+            const uint32_t last = count - 2;
+            const uint32_t s = hint > last ? last : hint;
+            if (t >= time(s)) {
+                if (s == last || t < time(s + 1)) {
+                    return s;
+                }
+                if (s + 1 == last || t < time(s + 2)) {
+                    return s + 1;
+                }
+            }
+            else if (s == 0 || t >= time(s - 1)) {
+                return s == 0 ? 0 : s - 1;
+            }
+            uint32_t lo = 0, hi = last;
+            while (lo < hi) {
+                const uint32_t mid = (lo + hi + 1) / 2;
+                if (time(mid) <= t) {
+                    lo = mid;
+                }
+                else {
+                    hi = mid - 1;
+                }
+            }
+            return lo;
+        }
+
+        // weights of (value0, out0, in1, value1) at t in the segment [t0, t1]
+        inline void Weights(Interpolation mode, Unit t0, Unit t1, Unit t, Unit (&w)[4]) {
+            const Unit one = Unit(1), zero = Unit(0);
+            const Unit duration = t1 - t0;
+            const Unit u = t <= t0 ? zero : (t >= t1 ? one : (t - t0) / duration);
+            switch (mode) {
+            case Interpolation::Hermite: {
+                const Unit u2 = u * u, u3 = u2 * u;
+                const Unit h00 = u3 + u3 - (u2 + u2 + u2) + one;
+                w[0] = h00;
+                w[1] = (u3 - (u2 + u2) + u) * duration;
+                w[2] = (u3 - u2) * duration;
+                w[3] = one - h00;
+                break;
+            }
+            case Interpolation::Bezier: {
+                const Unit v = one - u, v2 = v * v;
+                const Unit b1 = v2 * u, b2 = v * (u * u);
+                w[0] = v2 * v;
+                w[1] = b1 + b1 + b1;
+                w[2] = b2 + b2 + b2;
+                w[3] = one - w[0] - w[1] - w[2];
+                break;
+            }
+            default:
+                w[0] = one - u;
+                w[1] = zero;
+                w[2] = zero;
+                w[3] = u;
+                break;
+            }
+        }
+
+        inline Unit Blend(const Unit (&w)[4], Unit value0, Unit out0, Unit in1, Unit value1) {
+            const int64_t acc = static_cast<int64_t>(w[0].Raw()) * value0.Raw() + static_cast<int64_t>(w[1].Raw()) * out0.Raw() +
+                static_cast<int64_t>(w[2].Raw()) * in1.Raw() + static_cast<int64_t>(w[3].Raw()) * value1.Raw();
+            return Unit::From(static_cast<int32_t>((acc + (Unit::ONE / 2)) / Unit::ONE));
+        }
+    }
+
+    class KeyTrack {
+    public:
+        KeyTrack() = default;
+
+        // 'keys' must outlive the track; times must strictly increase
+        KeyTrack(const Keyframe* keys, uint32_t count, Interpolation mode) : _keys(keys), _count(count), _mode(mode) {
+            for (uint32_t i = 1; i < count; ++i) {
+                if (!(keys[i - 1].time < keys[i].time)) {
+                    GEKKO_MATH_ERROR("Key times must increase");
+                    _count = 0;
+                    return;
+                }
+            }
+        }
+
+        const Keyframe* Keys() const {
+            return _keys;
+        }
+
+        uint32_t Count() const {
+            return _count;
+        }
+
+        Interpolation Mode() const {
+            return _mode;
+        }
+
+        // value at time t, searching from the cursor and leaving it on the sampled segment
+        Unit Sample(Unit t, TrackCursor& cursor) const {
+            if (_count < 2) {
+                return _count == 1 ? _keys[0].value : Unit(0);
+            }
+            const Keyframe* keys = _keys;
+            const uint32_t s = Detail::Locate([keys](uint32_t i) { return keys[i].time; }, _count, t, cursor.segment);
+            cursor.segment = s;
+            const Keyframe& a = keys[s];
+            const Keyframe& b = keys[s + 1];
+            Unit w[4];
+            Detail::Weights(_mode, a.time, b.time, t, w);
+            return Detail::Blend(w, a.value, a.out, b.in, b.value);
+        }
+
+        // one-off sample with a binary search
+        Unit Sample(Unit t) const {
+            TrackCursor cursor;
+            return Sample(t, cursor);
+        }
+
+    private:
+        const Keyframe* _keys = nullptr;
+        uint32_t _count = 0;
+        Interpolation _mode = Interpolation::Linear;
+    };
+
+    // out[i] = tracks[i].Sample(t, cursors[i])
+    inline void Sample(const KeyTrack* tracks, size_t count, Unit t, TrackCursor* cursors, Unit* out) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = tracks[i].Sample(t, cursors[i]);
+        }
+    }
+
+    // 'channels' curves keyed at the same times with one interpolation. The streams are key-major:
+    // channel c of key k is at [k * channels + c]. 'ins' and 'outs' may be null for linear clips.
+    class KeyClip {
+    public:
+        KeyClip() = default;
+
+        KeyClip(const Unit* times, uint32_t count, uint32_t channels, Interpolation mode, const Unit* values,
+            const Unit* ins = nullptr, const Unit* outs = nullptr)
+            : _times(times), _values(values), _ins(ins), _outs(outs), _count(count), _channels(channels), _mode(mode) {
+            if (mode != Interpolation::Linear && (!ins || !outs)) {
+                GEKKO_MATH_ERROR("Cubic clips need in and out streams");
+                _count = 0;
+                return;
+            }
+            for (uint32_t i = 1; i < count; ++i) {
+                if (!(times[i - 1] < times[i])) {
+                    GEKKO_MATH_ERROR("Key times must increase");
+                    _count = 0;
+                    return;
+                }
+            }
+        }
+
+        uint32_t Count() const {
+            return _count;
+        }
+
+        uint32_t Channels() const {
+            return _channels;
+        }
+
+        Interpolation Mode() const {
+            return _mode;
+        }
+
+        // out[c] = channel c at time t, for all channels
+        void Sample(Unit t, TrackCursor& cursor, Unit* out) const {
+            if (_count < 2) {
+                for (uint32_t c = 0; c < _channels; ++c) {
+                    out[c] = _count == 1 ? _values[c] : Unit(0);
+                }
+                return;
+            }
+            const Unit* times = _times;
+            const uint32_t s = Detail::Locate([times](uint32_t i) { return times[i]; }, _count, t, cursor.segment);
+            cursor.segment = s;
+            Unit w[4];
+            Detail::Weights(_mode, times[s], times[s + 1], t, w);
+
+            const size_t k0 = static_cast<size_t>(s) * _channels, k1 = k0 + _channels;
+            const Unit* v0 = _values + k0;
+            const Unit* v1 = _values + k1;
+            if (_mode == Interpolation::Linear) {
+                const Unit none = Unit(0);
+                for (uint32_t c = 0; c < _channels; ++c) {
+                    out[c] = Detail::Blend(w, v0[c], none, none, v1[c]);
+                }
+                return;
+            }
+            const Unit* out0 = _outs + k0;
+            const Unit* in1 = _ins + k1;
+            for (uint32_t c = 0; c < _channels; ++c) {
+                out[c] = Detail::Blend(w, v0[c], out0[c], in1[c], v1[c]);
+            }
+        }
+
+        // channel c alone, with a binary search
+        Unit Sample(Unit t, uint32_t channel) const {
+            if (_count < 2) {
+                return _count == 1 ? _values[channel] : Unit(0);
+            }
+            const Unit* times = _times;
+            const uint32_t s = Detail::Locate([times](uint32_t i) { return times[i]; }, _count, t, 0);
+            Unit w[4];
+            Detail::Weights(_mode, times[s], times[s + 1], t, w);
+            const size_t k0 = static_cast<size_t>(s) * _channels + channel, k1 = k0 + _channels;
+            if (_mode == Interpolation::Linear) {
+                return Detail::Blend(w, _values[k0], Unit(0), Unit(0), _values[k1]);
+            }
+            return Detail::Blend(w, _values[k0], _outs[k0], _ins[k1], _values[k1]);
+        }
+
+    private:
+        const Unit* _times = nullptr;
+        const Unit* _values = nullptr;
+        const Unit* _ins = nullptr;
+        const Unit* _outs = nullptr;
+        uint32_t _count = 0;
+        uint32_t _channels = 0;
+        Interpolation _mode = Interpolation::Linear;
+    };
+}
@@ -0,0 +1,342 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GEKKO_MATH_CONVERT_AVX2 1
+#endif
+#if defined(__FMA__)
+#include <immintrin.h>
+#define GEKKO_MATH_CONVERT_FMA 1
+#elif defined(__ARM_FEATURE_FMA)
+#define GEKKO_MATH_CONVERT_FMA 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEKKO_MATH_CONVERT_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GEKKO_MATH_CONVERT_NEON 1
+#endif
+
+// VISUALIZATION ONLY
+// Bulk conversion of fixed-point data to floats for rendering, into caller-provided buffers.
+//
+// The kernels convert four (SSE2/NEON) or eight (AVX2) raw values at a time with an int-to-float
+// conversion and a multiply by 1/ONE. Scaling by a power of two is exact, so every output is
+// bit-identical to AsFloat on the same element. Buffers need no particular alignment.
+//
+//     AsFloat(units, n, out)                        Unit[n]        -> float[n]
+//     AsFloat(vecs, n, out)                         Vec3[n]        -> Vec3F[n]
+//     AsFloatInterleaved(vecs, n, xyz)              Vec3[n]        -> float[3n]  x y z x y z ...
+//     AsFloatPadded(vecs, n, xyzw, w)               Vec3[n]        -> float[4n]  x y z w ...
+//     AsFloatSoA(vecs, n, x, y, z)                  Vec3[n]        -> float[n] x3
+//     AsFloatInterleaved(x, y, z, n, xyz)           Unit[n] x3     -> float[3n]
+//
+// The AsFloatLerp variants interpolate between two snapshots while converting, for a renderer that
+// runs faster than the fixed tick: out = previous * (1 - alpha) + current * alpha, computed in float
+// on the converted values, so alpha 0 and 1 give exactly the previous and the current frame. The
+// multiply-add is fused when the target has FMA and separate otherwise, never left to the compiler,
+// so the bulk kernels match the single-element AsFloatLerp bit for bit on every target.
+//
+//     AsFloatLerp(prev, curr, alpha)                       Unit x2        -> float
+//     AsFloatLerp(prev, curr, n, alpha, out)               Unit[n] x2     -> float[n]
+//     AsFloatLerp(prev, curr, n, alpha, out)               Vec3[n] x2     -> Vec3F[n]
+//     AsFloatLerpInterleaved(prev, curr, n, alpha, xyz)    Vec3[n] x2     -> float[3n]
+//     AsFloatLerpPadded(prev, curr, n, alpha, xyzw, w)     Vec3[n] x2     -> float[4n]
+GEKKO_MATH_EXPORT namespace Gekko::Math {
+
+    namespace Detail {
+        static_assert(sizeof(Unit) == sizeof(int32_t), "Unit is a single raw int32");
+        static_assert(sizeof(Vec3) == 3 * sizeof(int32_t), "Vec3 is three packed Units");
+        static_assert(sizeof(Vec3F) == 3 * sizeof(float), "Vec3F is three packed floats");
+
+        constexpr float INV_ONE = 1.0f / Unit::ONE;
+
+        inline const int32_t* RawPtr(const Unit* u) {
+            return reinterpret_cast<const int32_t*>(u);
+        }
+
+        inline const int32_t* RawPtr(const Vec3* v) {
+            return reinterpret_cast<const int32_t*>(v);
+        }
+
+        inline float ToFloat(int32_t raw) {
+            return static_cast<float>(raw) * INV_ONE;
+        }
+
+        inline float Lerp(int32_t previous, int32_t current, float alpha, float beta) {
+#if defined(GEKKO_MATH_CONVERT_FMA)
+            return std::fma(ToFloat(current), alpha, ToFloat(previous) * beta);
+#else
+            return ToFloat(previous) * beta + ToFloat(current) * alpha;
+#endif
+        }
+
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        inline __m128 Load4(const int32_t* in) {
+            return _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))), _mm_set1_ps(INV_ONE));
+        }
+
+        inline __m128 Lerp4(const int32_t* previous, const int32_t* current, __m128 alpha, __m128 beta) {
+#if defined(GEKKO_MATH_CONVERT_FMA)
+            return _mm_fmadd_ps(Load4(current), alpha, _mm_mul_ps(Load4(previous), beta));
+#else
+            return _mm_add_ps(_mm_mul_ps(Load4(previous), beta), _mm_mul_ps(Load4(current), alpha));
+#endif
+        }
+
+        // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3 to x0 y0 z0 w .. x3 y3 z3 w
+        inline void StorePadded4(__m128 a, __m128 b, __m128 c, __m128 w, float* out) {
+            __m128 t0 = _mm_shuffle_ps(a, w, _MM_SHUFFLE(0, 0, 2, 2));
+            __m128 t1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 3, 3));
+            __m128 t2 = _mm_shuffle_ps(b, w, _MM_SHUFFLE(0, 0, 1, 1));
+            __m128 t3 = _mm_shuffle_ps(c, w, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 t4 = _mm_shuffle_ps(c, w, _MM_SHUFFLE(0, 0, 3, 3));
+            _mm_storeu_ps(out + 0, _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(out + 4, _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(out + 8, _mm_shuffle_ps(b, t3, _MM_SHUFFLE(2, 0, 3, 2)));
+            _mm_storeu_ps(out + 12, _mm_shuffle_ps(c, t4, _MM_SHUFFLE(2, 0, 2, 1)));
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        inline float32x4_t Convert4(int32x4_t raw) {
+            return vmulq_n_f32(vcvtq_f32_s32(raw), INV_ONE);
+        }
+
+        inline float32x4_t Lerp4(int32x4_t previous, int32x4_t current, float alpha, float beta) {
+#if defined(GEKKO_MATH_CONVERT_FMA)
+            return vfmaq_n_f32(vmulq_n_f32(Convert4(previous), beta), Convert4(current), alpha);
+#else
+            return vaddq_f32(vmulq_n_f32(Convert4(previous), beta), vmulq_n_f32(Convert4(current), alpha));
+#endif
+        }
+#endif
+
+        // the flat case: n raw values to n floats
+        inline void RawToFloat(const int32_t* in, size_t n, float* out) {
+            size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_AVX2)
+            const __m256 scale8 = _mm256_set1_ps(INV_ONE);
+            for (const size_t body = n & ~size_t(7); i < body; i += 8) {
+                __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(r), scale8));
+            }
+#endif
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+            for (const size_t body = n & ~size_t(3); i < body; i += 4) {
+                _mm_storeu_ps(out + i, Load4(in + i));
+            }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+            for (const size_t body = n & ~size_t(3); i < body; i += 4) {
+                vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), INV_ONE));
+            }
+#endif
+            for (; i < n; ++i) {
+                out[i] = ToFloat(in[i]);
+            }
+        }
+    }
+
+    inline void AsFloat(const Unit* in, size_t count, float* out) {
+        Detail::RawToFloat(Detail::RawPtr(in), count, out);
+    }
+
+    inline void AsFloatInterleaved(const Vec3* in, size_t count, float* xyz) {
+        Detail::RawToFloat(Detail::RawPtr(in), 3 * count, xyz);
+    }
+
+    inline void AsFloat(const Vec3* in, size_t count, Vec3F* out) {
+        AsFloatInterleaved(in, count, reinterpret_cast<float*>(out));
+    }
+
+    // xyz plus a constant w per vector, for 16-byte vertex attributes
+    inline void AsFloatPadded(const Vec3* in, size_t count, float* xyzw, float w = 0.0f) {
+        const int32_t* raw = Detail::RawPtr(in);
+        size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        const __m128 wv = _mm_set1_ps(w);
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            __m128 a = Detail::Load4(raw + 3 * i);
+            __m128 b = Detail::Load4(raw + 3 * i + 4);
+            __m128 c = Detail::Load4(raw + 3 * i + 8);
+            Detail::StorePadded4(a, b, c, wv, xyzw + 4 * i);
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            int32x4x3_t r = vld3q_s32(raw + 3 * i);
+            float32x4x4_t f;
+            f.val[0] = vmulq_n_f32(vcvtq_f32_s32(r.val[0]), Detail::INV_ONE);
+            f.val[1] = vmulq_n_f32(vcvtq_f32_s32(r.val[1]), Detail::INV_ONE);
+            f.val[2] = vmulq_n_f32(vcvtq_f32_s32(r.val[2]), Detail::INV_ONE);
+            f.val[3] = vdupq_n_f32(w);
+            vst4q_f32(xyzw + 4 * i, f);
+        }
+#endif
+        for (; i < count; ++i) {
+            xyzw[4 * i + 0] = Detail::ToFloat(raw[3 * i + 0]);
+            xyzw[4 * i + 1] = Detail::ToFloat(raw[3 * i + 1]);
+            xyzw[4 * i + 2] = Detail::ToFloat(raw[3 * i + 2]);
+            xyzw[4 * i + 3] = w;
+        }
+    }
+
+    // one float stream per axis
+    inline void AsFloatSoA(const Vec3* in, size_t count, float* x, float* y, float* z) {
+        const int32_t* raw = Detail::RawPtr(in);
+        size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            __m128 a = Detail::Load4(raw + 3 * i);
+            __m128 b = Detail::Load4(raw + 3 * i + 4);
+            __m128 c = Detail::Load4(raw + 3 * i + 8);
+            __m128 bc_x = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));   // x2 x2 x3 x3
+            __m128 ab_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));   // y0 y0 y1 y1
+            __m128 bc_y = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));   // y2 y2 y3 y3
+            __m128 ab_z = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));   // z0 z0 z1 z1
+            __m128 cc_z = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));   // z2 z2 z3 z3
+            _mm_storeu_ps(x + i, _mm_shuffle_ps(a, bc_x, _MM_SHUFFLE(2, 0, 3, 0)));
+            _mm_storeu_ps(y + i, _mm_shuffle_ps(ab_y, bc_y, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(z + i, _mm_shuffle_ps(ab_z, cc_z, _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            int32x4x3_t r = vld3q_s32(raw + 3 * i);
+            vst1q_f32(x + i, vmulq_n_f32(vcvtq_f32_s32(r.val[0]), Detail::INV_ONE));
+            vst1q_f32(y + i, vmulq_n_f32(vcvtq_f32_s32(r.val[1]), Detail::INV_ONE));
+            vst1q_f32(z + i, vmulq_n_f32(vcvtq_f32_s32(r.val[2]), Detail::INV_ONE));
+        }
+#endif
+        for (; i < count; ++i) {
+            x[i] = Detail::ToFloat(raw[3 * i + 0]);
+            y[i] = Detail::ToFloat(raw[3 * i + 1]);
+            z[i] = Detail::ToFloat(raw[3 * i + 2]);
+        }
+    }
+
+    // SoA Unit streams to interleaved xyz floats
+    inline void AsFloatInterleaved(const Unit* xs, const Unit* ys, const Unit* zs, size_t count, float* xyz) {
+        const int32_t* rx = Detail::RawPtr(xs);
+        const int32_t* ry = Detail::RawPtr(ys);
+        const int32_t* rz = Detail::RawPtr(zs);
+        size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            __m128 x = Detail::Load4(rx + i);
+            __m128 y = Detail::Load4(ry + i);
+            __m128 z = Detail::Load4(rz + i);
+            __m128 xy_lo = _mm_unpacklo_ps(x, y);                           // x0 y0 x1 y1
+            __m128 xy_hi = _mm_unpackhi_ps(x, y);                           // x2 y2 x3 y3
+            __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));      // z0 z0 x1 x1
+            __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));      // y1 y1 z1 z1
+            __m128 zx3 = _mm_shuffle_ps(z, xy_hi, _MM_SHUFFLE(2, 2, 2, 2)); // z2 z2 x3 x3
+            __m128 yz3 = _mm_shuffle_ps(xy_hi, z, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+            float* o = xyz + 3 * i;
+            _mm_storeu_ps(o + 0, _mm_shuffle_ps(xy_lo, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(o + 4, _mm_shuffle_ps(yz, xy_hi, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(o + 8, _mm_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            float32x4x3_t f;
+            f.val[0] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(rx + i)), Detail::INV_ONE);
+            f.val[1] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(ry + i)), Detail::INV_ONE);
+            f.val[2] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(rz + i)), Detail::INV_ONE);
+            vst3q_f32(xyz + 3 * i, f);
+        }
+#endif
+        for (; i < count; ++i) {
+            xyz[3 * i + 0] = Detail::ToFloat(rx[i]);
+            xyz[3 * i + 1] = Detail::ToFloat(ry[i]);
+            xyz[3 * i + 2] = Detail::ToFloat(rz[i]);
+        }
+    }
+
+    // the per-element definition the bulk interpolation kernels follow
+    inline float AsFloatLerp(Unit previous, Unit current, float alpha) {
+        return Detail::Lerp(previous.Raw(), current.Raw(), alpha, 1.0f - alpha);
+    }
+
+    inline void AsFloatLerp(const Unit* previous, const Unit* current, size_t count, float alpha, float* out) {
+        const int32_t* p = Detail::RawPtr(previous);
+        const int32_t* c = Detail::RawPtr(current);
+        const float beta = 1.0f - alpha;
+        size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_AVX2)
+        const __m256 scale8 = _mm256_set1_ps(Detail::INV_ONE);
+        const __m256 alpha8 = _mm256_set1_ps(alpha);
+        const __m256 beta8 = _mm256_set1_ps(beta);
+        for (const size_t body = count & ~size_t(7); i < body; i += 8) {
+            __m256 fp = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i))), scale8);
+            __m256 fc = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + i))), scale8);
+#if defined(GEKKO_MATH_CONVERT_FMA)
+            _mm256_storeu_ps(out + i, _mm256_fmadd_ps(fc, alpha8, _mm256_mul_ps(fp, beta8)));
+#else
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(fp, beta8), _mm256_mul_ps(fc, alpha8)));
+#endif
+        }
+#endif
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        const __m128 alpha4 = _mm_set1_ps(alpha);
+        const __m128 beta4 = _mm_set1_ps(beta);
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            _mm_storeu_ps(out + i, Detail::Lerp4(p + i, c + i, alpha4, beta4));
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            vst1q_f32(out + i, Detail::Lerp4(vld1q_s32(p + i), vld1q_s32(c + i), alpha, beta));
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i] = Detail::Lerp(p[i], c[i], alpha, beta);
+        }
+    }
+
+    inline void AsFloatLerpInterleaved(const Vec3* previous, const Vec3* current, size_t count, float alpha, float* xyz) {
+        AsFloatLerp(reinterpret_cast<const Unit*>(previous), reinterpret_cast<const Unit*>(current), 3 * count, alpha, xyz);
+    }
+
+    inline void AsFloatLerp(const Vec3* previous, const Vec3* current, size_t count, float alpha, Vec3F* out) {
+        AsFloatLerpInterleaved(previous, current, count, alpha, reinterpret_cast<float*>(out));
+    }
+
+    inline void AsFloatLerpPadded(const Vec3* previous, const Vec3* current, size_t count, float alpha, float* xyzw, float w = 0.0f) {
+        const int32_t* p = Detail::RawPtr(previous);
+        const int32_t* c = Detail::RawPtr(current);
+        const float beta = 1.0f - alpha;
+        size_t i = 0;
+#if defined(GEKKO_MATH_CONVERT_SSE2)
+        const __m128 alpha4 = _mm_set1_ps(alpha);
+        const __m128 beta4 = _mm_set1_ps(beta);
+        const __m128 wv = _mm_set1_ps(w);
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            const size_t r = 3 * i;
+            __m128 a = Detail::Lerp4(p + r, c + r, alpha4, beta4);
+            __m128 b = Detail::Lerp4(p + r + 4, c + r + 4, alpha4, beta4);
+            __m128 d = Detail::Lerp4(p + r + 8, c + r + 8, alpha4, beta4);
+            Detail::StorePadded4(a, b, d, wv, xyzw + 4 * i);
+        }
+#elif defined(GEKKO_MATH_CONVERT_NEON)
+        for (const size_t body = count & ~size_t(3); i < body; i += 4) {
+            int32x4x3_t rp = vld3q_s32(p + 3 * i);
+            int32x4x3_t rc = vld3q_s32(c + 3 * i);
+            float32x4x4_t f;
+            f.val[0] = Detail::Lerp4(rp.val[0], rc.val[0], alpha, beta);
+            f.val[1] = Detail::Lerp4(rp.val[1], rc.val[1], alpha, beta);
+            f.val[2] = Detail::Lerp4(rp.val[2], rc.val[2], alpha, beta);
+            f.val[3] = vdupq_n_f32(w);
+            vst4q_f32(xyzw + 4 * i, f);
+        }
+#endif
+        for (; i < count; ++i) {
+            xyzw[4 * i + 0] = Detail::Lerp(p[3 * i + 0], c[3 * i + 0], alpha, beta);
+            xyzw[4 * i + 1] = Detail::Lerp(p[3 * i + 1], c[3 * i + 1], alpha, beta);
+            xyzw[4 * i + 2] = Detail::Lerp(p[3 * i + 2], c[3 * i + 2], alpha, beta);
+            xyzw[4 * i + 3] = w;
+        }
+    }
+}
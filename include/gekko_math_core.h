@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstdint>
+
+// Core Unit/Vec3 types with no dependency beyond <cstdint> when errors trap.
+//
+// Division by zero and the square root of a negative number go through GEKKO_MATH_ERROR(msg). It
+// throws std::runtime_error unless GEKKO_MATH_TRAP_ON_ERROR is defined, in which case it traps and
+// <stdexcept> is not included. The operators are inline, so the policy is a program-wide setting:
+// define it (or a custom GEKKO_MATH_ERROR) for every translation unit, e.g. with the CMake option
+// GEKKO_MATH_TRAP_ON_ERROR, never in a source file. Include order does not matter.
+#ifndef GEKKO_MATH_ERROR
+#if defined(GEKKO_MATH_TRAP_ON_ERROR)
+#if defined(_MSC_VER)
+#define GEKKO_MATH_ERROR(msg) __debugbreak()
+#else
+#define GEKKO_MATH_ERROR(msg) __builtin_trap()
+#endif
+#else
+#include <stdexcept>
+#define GEKKO_MATH_ERROR(msg) throw std::runtime_error(msg)
+#endif
+#endif
+
+// set to `export` by module/gekko_math.cppm, empty for normal includes
+#ifndef GEKKO_MATH_EXPORT
+#define GEKKO_MATH_EXPORT
+#endif
+
+// operation counting build, see gekko_math_stats.h
+#if defined(GEKKO_MATH_COUNT_OPS)
+#include "gekko_math_stats.h"
+#else
+#define GEKKO_MATH_COUNT(field) ((void)0)
+#define GEKKO_MATH_COUNT_SQRT(raw, iterations, capped) ((void)0)
+#endif
+
+GEKKO_MATH_EXPORT namespace Gekko::Math {
+
+    struct Unit {
+    private:
+        int32_t _raw;
+
+    public:
+        static const int32_t ONE = 0x8000;
+        static const int32_t HALF = 0x4000;
+
+        // SqrtNewton iteration cap
+        static const int SQRT_MAX_ITER = 10;
+
+        Unit() = default;
+        Unit(int32_t val) : _raw(val * ONE) {}
+        Unit(const Unit& val) = default;
+
+        static Unit From(int32_t val) {
+            Unit value {};
+            value._raw = val;
+            return value;
+        }
+
+        int32_t Raw() const {
+            return _raw;
+        }
+
+        bool operator>(const Unit& other) const {
+            return _raw > other._raw;
+        }
+
+        bool operator>=(const Unit& other) const {
+            return _raw >= other._raw;
+        }
+
+        bool operator<(const Unit& other) const {
+            return _raw < other._raw;
+        }
+
+        bool operator<=(const Unit& other) const {
+            return _raw <= other._raw;
+        }
+
+        bool operator>(const int32_t& other) const {
+            return _raw > other;
+        }
+
+        bool operator>=(const int32_t& other) const {
+            return _raw >= other;
+        }
+
+        bool operator<(const int32_t& other) const {
+            return _raw < other;
+        }
+
+        bool operator<=(const int32_t& other) const {
+            return _raw <= other;
+        }
+
+        Unit operator-() const {
+            return Unit::From(-_raw);
+        }
+
+        Unit operator+(const Unit& other) const {
+            return Unit::From(_raw + other._raw);
+        }
+
+        Unit& operator+=(const Unit& other) {
+            _raw += other._raw;
+            return *this;
+        }
+
+        Unit operator-(const Unit& other) const {
+            return Unit::From(_raw - other._raw);
+        }
+
+        Unit& operator-=(const Unit& other) {
+            _raw -= other._raw;
+            return *this;
+        }
+
+        Unit operator/(const Unit& other) const {
+            GEKKO_MATH_COUNT(div);
+            if (other._raw == 0) {
+                GEKKO_MATH_ERROR("Division by zero");
+            }
+            int64_t num = static_cast<int64_t>(_raw) * ONE;
+            int64_t adjust = (other._raw < 0 ? -other._raw : other._raw) / 2;
+            return Unit::From(static_cast<int32_t>((num + (other._raw > 0 ? adjust : -adjust)) / other._raw));
+        }
+
+        Unit operator*(const Unit& other) const {
+            GEKKO_MATH_COUNT(mul);
+            int64_t result = static_cast<int64_t>(_raw) * other._raw;
+            return Unit::From(static_cast<int32_t>((result + (ONE / 2)) / ONE));
+        }
+
+        bool operator==(const Unit& other) const {
+            return _raw == other._raw;
+        }
+
+        bool operator!=(const Unit& other) const {
+            return _raw != other._raw;
+        }
+
+        Unit& operator*=(const Unit& other) {
+            *this = *this * other;
+            return *this;
+        }
+
+        Unit& operator/=(const Unit& other) {
+            *this = *this / other;
+            return *this;
+        }
+
+        // Newton‑Raphson square root for fixed‑point unit
+        static Unit SqrtNewton(const Unit& u) {
+            GEKKO_MATH_COUNT(sqrt);
+            if (u._raw < 0) {
+                GEKKO_MATH_ERROR("sqrt of negative number");
+            }
+
+            if (u._raw == 0) {
+                return 0;
+            }
+
+            // use u if it's at least 1, else default to 1 as the initial guess
+            Unit x = (u._raw >= Unit::ONE ? u : Unit::From(Unit::ONE));
+
+            // maximum iterations typically converges in fewer iterations given the precision
+            int i = 0;
+            for (; i < SQRT_MAX_ITER; ++i) {
+                GEKKO_MATH_COUNT(newton_iterations);
+                // x + u / x exceeds int32 near the top of the range, so sum and halve in 64 bits;
+                // (sum + 1) / 2 rounds like Unit / 2 did and is counted as that divide
+                GEKKO_MATH_COUNT(div);
+                int64_t sum = static_cast<int64_t>(x._raw) + (u / x)._raw;
+                Unit next = Unit::From(static_cast<int32_t>((sum + 1) / 2));
+                if (next == x) {  // convergence check: no change in fixed‑point representation
+                    break;
+                }
+                x = next;
+            }
+            GEKKO_MATH_COUNT_SQRT(u._raw, i < SQRT_MAX_ITER ? i + 1 : i, i == SQRT_MAX_ITER);
+            return x;
+        }
+
+        // VISUALIZATION ONLY
+        inline float AsFloat() const {
+            return static_cast<float>(_raw) / ONE;
+        }
+    };
+
+    inline Unit Min(const Unit& a, const Unit& b) {
+        return (a < b) ? a : b;
+    }
+
+    inline Unit Max(const Unit& a, const Unit& b) {
+        return (a > b) ? a : b;
+    }
+
+    namespace Detail {
+        // floor(sqrt(x)), bit by bit, for the headers built on Unit
+        inline uint64_t ISqrt(uint64_t x) {
+            uint64_t root = 0, bit = uint64_t(1) << 62;
+            while (bit > x) {
+                bit >>= 2;
+            }
+            while (bit != 0) {
+                if (x >= root + bit) {
+                    x -= root + bit;
+                    root = (root >> 1) + bit;
+                }
+                else {
+                    root >>= 1;
+                }
+                bit >>= 2;
+            }
+            return root;
+        }
+    }
+
+    // VISUALIZATION ONLY
+    struct Vec3F {
+        float x, y, z;
+        Vec3F() = default;
+        Vec3F(float xx, float yy, float zz) : x(xx), y(yy), z(zz) {}
+    };
+
+    struct Vec3 {
+        Unit x, y, z;
+
+        Vec3() = default;
+        Vec3(const Vec3& v) = default;
+        Vec3(const Unit& xx, const Unit& yy, const Unit& zz) : x(xx), y(yy), z(zz) {}
+
+        Unit Dot(const Vec3& other) const {
+            return (x * other.x) + (y * other.y) + (z * other.z);
+        }
+
+        Vec3 operator+(const Vec3& other) const {
+            return Vec3(x + other.x, y + other.y, z + other.z);
+        }
+
+        Vec3& operator+=(const Vec3& other) {
+            *this = *this + other;
+            return *this;
+        }
+
+        Vec3 operator+(const Unit& other) const {
+            return Vec3(x + other, y + other, z + other);
+        }
+
+        Vec3& operator+=(const Unit& other) {
+            *this = *this + other;
+            return *this;
+        }
+
+        Vec3 operator-(const Vec3& other) const {
+            return Vec3(x - other.x, y - other.y, z - other.z);
+        }
+
+        Vec3& operator-=(const Vec3& other) {
+            *this = *this - other;
+            return *this;
+        }
+
+        Vec3 operator-(const Unit& other) const {
+            return Vec3(x - other, y - other, z - other);
+        }
+
+        Vec3& operator-=(const Unit& other) {
+            *this = *this - other;
+            return *this;
+        }
+
+        Vec3 operator/(const Vec3& other) const {
+            return Vec3(x / other.x, y / other.y, z / other.z);
+        }
+
+        Vec3 operator/(const Unit& other) const {
+            return Vec3(x / other, y / other, z / other);
+        }
+
+        Vec3& operator/=(const Vec3& other) {
+            *this = *this / other;
+            return *this;
+        }
+
+        Vec3& operator/=(const Unit& other) {
+            *this = *this / other;
+            return *this;
+        }
+
+        Vec3 operator*(const Vec3& other) const {
+            return Vec3(x * other.x, y * other.y, z * other.z);
+        }
+
+        Vec3 operator*(const Unit& other) const {
+            return Vec3(x * other, y * other, z * other);
+        }
+
+        Vec3& operator*=(const Vec3& other) {
+            *this = *this * other;
+            return *this;
+        }
+
+        Vec3& operator*=(const Unit& other) {
+            *this = *this * other;
+            return *this;
+        }
+
+        bool operator==(const Vec3& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+
+        bool operator!=(const Vec3& other) const {
+            return !(*this == other);
+        }
+
+        // VISUALIZATION ONLY
+        Vec3F AsFloat() const {
+            return Vec3F(x.AsFloat(), y.AsFloat(), z.AsFloat());
+        }
+    };
+}
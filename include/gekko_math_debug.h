@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <ostream>
+
+GEKKO_MATH_EXPORT namespace Gekko::Math {
+
+    // VISUALIZATION ONLY
+    inline std::ostream& operator<<(std::ostream& os, const Unit& u) {
+        return os << u.AsFloat();
+    }
+
+    // VISUALIZATION ONLY
+    inline std::ostream& operator<<(std::ostream& os, const Vec3F& v) {
+        return os << "(" << v.x << ", " << v.y << ", " << v.z << ")";
+    }
+
+    // VISUALIZATION ONLY
+    inline std::ostream& operator<<(std::ostream& os, const Vec3& v) {
+        return os << v.AsFloat();
+    }
+}
\ No newline at end of file
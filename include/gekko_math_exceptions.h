@@ -0,0 +1,7 @@
+#pragma once
+
+// Kept for existing includers. Errors throw std::runtime_error unless the program is built with
+// GEKKO_MATH_TRAP_ON_ERROR, see gekko_math_core.h.
+#include <stdexcept>
+
+#include "gekko_math_core.h"
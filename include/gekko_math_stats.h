@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Operation counting for budget checks, enabled by defining GEKKO_MATH_COUNT_OPS.
+//
+// In a counting build every Unit multiply, divide and SqrtNewton call (with its Newton iterations)
+// is tallied in thread-local counters. Divides issued inside SqrtNewton count as divides as well.
+// Scope objects attribute the counts of a region to a name, and a tick loop reads and clears
+// everything with SnapshotAndReset:
+//
+//     void Physics() { Gekko::Math::Stats::Scope scope("physics"); ... }
+//
+//     auto tick = Gekko::Math::Stats::SnapshotAndReset();
+//     if (!tick.total.Within(budget)) { ... }
+//
+// SqrtStats additionally records how many Newton iterations each SqrtNewton call took, how often
+// it stopped at the iteration cap without converging, and both broken down by input magnitude.
+//
+// Without GEKKO_MATH_COUNT_OPS nothing in Unit touches these counters.
+#ifndef GEKKO_MATH_EXPORT
+#define GEKKO_MATH_EXPORT
+#endif
+
+GEKKO_MATH_EXPORT namespace Gekko::Math::Stats {
+
+    struct OpCounts {
+        uint64_t mul = 0;
+        uint64_t div = 0;
+        uint64_t sqrt = 0;
+        uint64_t newton_iterations = 0;
+
+        OpCounts& operator+=(const OpCounts& other) {
+            mul += other.mul;
+            div += other.div;
+            sqrt += other.sqrt;
+            newton_iterations += other.newton_iterations;
+            return *this;
+        }
+
+        OpCounts operator-(const OpCounts& other) const {
+            OpCounts d;
+            d.mul = mul - other.mul;
+            d.div = div - other.div;
+            d.sqrt = sqrt - other.sqrt;
+            d.newton_iterations = newton_iterations - other.newton_iterations;
+            return d;
+        }
+
+        // true when no counter is above the same counter in 'budget'
+        bool Within(const OpCounts& budget) const {
+            return mul <= budget.mul && div <= budget.div && sqrt <= budget.sqrt &&
+                newton_iterations <= budget.newton_iterations;
+        }
+    };
+
+    inline constexpr int SQRT_HISTOGRAM = 16;   // iteration counts at or above are folded into the last bin
+    inline constexpr int SQRT_OCTAVES = 32;     // 1 + floor(log2(raw)) of the input, 0 is unused
+
+    // convergence of SqrtNewton, zero inputs return before iterating and are not recorded
+    struct SqrtStats {
+        uint64_t iterations[SQRT_HISTOGRAM] = {};   // calls by iteration count
+        uint64_t cap_hits = 0;                      // calls that reached the cap without converging
+        uint64_t octave_calls[SQRT_OCTAVES] = {};
+        uint64_t octave_iterations[SQRT_OCTAVES] = {};
+        uint64_t octave_cap_hits[SQRT_OCTAVES] = {};
+        uint32_t octave_max_iterations[SQRT_OCTAVES] = {};
+
+        uint64_t Calls() const {
+            uint64_t n = 0;
+            for (uint64_t c : iterations) {
+                n += c;
+            }
+            return n;
+        }
+
+        double MeanIterations(int octave) const {
+            return octave_calls[octave] ? static_cast<double>(octave_iterations[octave]) / octave_calls[octave] : 0.0;
+        }
+
+        // smallest and largest input octave with cap hits, -1 when there were none
+        int FirstCapOctave() const {
+            for (int o = 0; o < SQRT_OCTAVES; ++o) {
+                if (octave_cap_hits[o]) {
+                    return o;
+                }
+            }
+            return -1;
+        }
+
+        int LastCapOctave() const {
+            for (int o = SQRT_OCTAVES - 1; o >= 0; --o) {
+                if (octave_cap_hits[o]) {
+                    return o;
+                }
+            }
+            return -1;
+        }
+
+        void Record(int32_t raw, int iterations_done, bool capped) {
+            int octave = 0;
+            for (uint32_t m = static_cast<uint32_t>(raw); m; m >>= 1) {
+                ++octave;
+            }
+            octave = octave < SQRT_OCTAVES ? octave : SQRT_OCTAVES - 1;
+            iterations[iterations_done < SQRT_HISTOGRAM ? iterations_done : SQRT_HISTOGRAM - 1]++;
+            octave_calls[octave]++;
+            octave_iterations[octave] += static_cast<uint64_t>(iterations_done);
+            if (static_cast<uint32_t>(iterations_done) > octave_max_iterations[octave]) {
+                octave_max_iterations[octave] = static_cast<uint32_t>(iterations_done);
+            }
+            if (capped) {
+                cap_hits++;
+                octave_cap_hits[octave]++;
+            }
+        }
+
+        SqrtStats& operator+=(const SqrtStats& other) {
+            for (int i = 0; i < SQRT_HISTOGRAM; ++i) {
+                iterations[i] += other.iterations[i];
+            }
+            cap_hits += other.cap_hits;
+            for (int o = 0; o < SQRT_OCTAVES; ++o) {
+                octave_calls[o] += other.octave_calls[o];
+                octave_iterations[o] += other.octave_iterations[o];
+                octave_cap_hits[o] += other.octave_cap_hits[o];
+                if (other.octave_max_iterations[o] > octave_max_iterations[o]) {
+                    octave_max_iterations[o] = other.octave_max_iterations[o];
+                }
+            }
+            return *this;
+        }
+    };
+
+    struct ScopeCounts {
+        const char* name = nullptr;
+        uint64_t calls = 0;
+        OpCounts ops;   // inclusive of nested scopes
+    };
+
+    inline constexpr uint32_t MAX_SCOPES = 32;
+
+    // counters of one thread
+    struct Snapshot {
+        OpCounts total;
+        SqrtStats sqrt;
+        ScopeCounts scopes[MAX_SCOPES];
+        uint32_t scope_count = 0;
+        bool scopes_overflowed = false;   // more than MAX_SCOPES names were used
+
+        const ScopeCounts* Find(const char* name) const {
+            for (uint32_t i = 0; i < scope_count; ++i) {
+                if (std::strcmp(scopes[i].name, name) == 0) {
+                    return &scopes[i];
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    namespace Detail {
+        struct ThreadState {
+            Snapshot counts;
+            uint64_t epoch = 0;   // bumped by Reset so open scopes do not subtract stale starts
+        };
+
+        inline ThreadState& Local() {
+            thread_local ThreadState state;
+            return state;
+        }
+
+        // index of 'name' in the scope table, MAX_SCOPES when the table is full
+        inline uint32_t ScopeIndex(Snapshot& s, const char* name) {
+            for (uint32_t i = 0; i < s.scope_count; ++i) {
+                if (s.scopes[i].name == name || std::strcmp(s.scopes[i].name, name) == 0) {
+                    return i;
+                }
+            }
+            if (s.scope_count == MAX_SCOPES) {
+                s.scopes_overflowed = true;
+                return MAX_SCOPES;
+            }
+            s.scopes[s.scope_count].name = name;
+            return s.scope_count++;
+        }
+    }
+
+    inline OpCounts& Counters() {
+        return Detail::Local().counts.total;
+    }
+
+    inline SqrtStats& Sqrt() {
+        return Detail::Local().counts.sqrt;
+    }
+
+    inline Snapshot Read() {
+        return Detail::Local().counts;
+    }
+
+    // clears the totals and every scope of the calling thread, the scope names are kept
+    inline void Reset() {
+        Detail::ThreadState& state = Detail::Local();
+        state.counts.total = OpCounts();
+        state.counts.sqrt = SqrtStats();
+        for (uint32_t i = 0; i < state.counts.scope_count; ++i) {
+            state.counts.scopes[i].calls = 0;
+            state.counts.scopes[i].ops = OpCounts();
+        }
+        state.counts.scopes_overflowed = false;
+        state.epoch++;
+    }
+
+    inline Snapshot SnapshotAndReset() {
+        Snapshot s = Read();
+        Reset();
+        return s;
+    }
+
+    // attributes the operations issued during its lifetime to 'name' (a string with static storage)
+    class Scope {
+    public:
+        explicit Scope(const char* name) {
+            Detail::ThreadState& state = Detail::Local();
+            _index = Detail::ScopeIndex(state.counts, name);
+            _epoch = state.epoch;
+            _start = state.counts.total;
+        }
+
+        ~Scope() {
+            Detail::ThreadState& state = Detail::Local();
+            if (_index == MAX_SCOPES) {
+                return;
+            }
+            ScopeCounts& scope = state.counts.scopes[_index];
+            scope.calls++;
+            // after a Reset inside the scope only the part since the reset is counted
+            scope.ops += (_epoch == state.epoch) ? state.counts.total - _start : state.counts.total;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        uint32_t _index;
+        uint64_t _epoch;
+        OpCounts _start;
+    };
+}
+
+#if defined(GEKKO_MATH_COUNT_OPS)
+#define GEKKO_MATH_COUNT(field) (++::Gekko::Math::Stats::Counters().field)
+#define GEKKO_MATH_COUNT_SQRT(raw, iterations, capped) (::Gekko::Math::Stats::Sqrt().Record(raw, iterations, capped))
+#else
+#define GEKKO_MATH_COUNT(field) ((void)0)
+#define GEKKO_MATH_COUNT_SQRT(raw, iterations, capped) ((void)0)
+#endif
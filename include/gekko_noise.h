@@ -0,0 +1,660 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GEKKO_NOISE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#define GEKKO_NOISE_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GEKKO_NOISE_NEON 1
+#endif
+
+// Deterministic gradient noise for procedural wind, terrain and jitter.
+//
+// Perlin (improved, quintic fade) and simplex noise in 2D and 3D over Unit coordinates, with the
+// integer lattice at whole units. Everything is 32-bit integer math: lattice points are hashed
+// with a multiply-xorshift mix of the seed and the cell, and positions inside a cell keep 12
+// fractional bits so every product fits in 32 bits. The result is a Unit of roughly [-1, 1],
+// within about 0.005 of the same noise in floating point, exactly 0 at lattice points for Perlin,
+// and identical on every platform. Any Unit is a valid coordinate.
+//
+//     Unit gust = Perlin(Vec3(x, y, time), seed);
+//     Simplex(xs, ys, count, heights, seed);     // SoA batch, 4 or 8 points per step
+//
+// The kernels are written once over a lane type, so the batched samplers run the same operations
+// as the scalar functions on several points at a time (SSE2/SSE4.1, AVX2, NEON) and agree with
+// them bit for bit; the remainder of a batch goes through the scalar kernel.
+namespace Gekko::Math {
+
+    namespace Detail {
+        constexpr int32_t NOISE_ONE = 1 << 12;
+
+        // one 32-bit lane; + - * wrap like the vector lanes do
+        struct NoiseScalar {
+            int32_t v;
+
+            static NoiseScalar Set(int32_t c) {
+                return NoiseScalar{ c };
+            }
+
+            friend NoiseScalar operator+(NoiseScalar a, NoiseScalar b) {
+                return { static_cast<int32_t>(static_cast<uint32_t>(a.v) + static_cast<uint32_t>(b.v)) };
+            }
+
+            friend NoiseScalar operator-(NoiseScalar a, NoiseScalar b) {
+                return { static_cast<int32_t>(static_cast<uint32_t>(a.v) - static_cast<uint32_t>(b.v)) };
+            }
+
+            friend NoiseScalar operator*(NoiseScalar a, NoiseScalar b) {
+                return { static_cast<int32_t>(static_cast<uint32_t>(a.v) * static_cast<uint32_t>(b.v)) };
+            }
+
+            friend NoiseScalar operator&(NoiseScalar a, NoiseScalar b) {
+                return { a.v & b.v };
+            }
+
+            friend NoiseScalar operator|(NoiseScalar a, NoiseScalar b) {
+                return { a.v | b.v };
+            }
+
+            friend NoiseScalar operator^(NoiseScalar a, NoiseScalar b) {
+                return { a.v ^ b.v };
+            }
+
+            // all ones where a > b
+            friend NoiseScalar Gt(NoiseScalar a, NoiseScalar b) {
+                return { a.v > b.v ? -1 : 0 };
+            }
+
+            friend NoiseScalar Eq(NoiseScalar a, NoiseScalar b) {
+                return { a.v == b.v ? -1 : 0 };
+            }
+        };
+
+        template <int N>
+        NoiseScalar Sra(NoiseScalar a) {
+            return { a.v >> N };
+        }
+
+        template <int N>
+        NoiseScalar Srl(NoiseScalar a) {
+            return { static_cast<int32_t>(static_cast<uint32_t>(a.v) >> N) };
+        }
+
+        template <int N>
+        NoiseScalar Shl(NoiseScalar a) {
+            return { static_cast<int32_t>(static_cast<uint32_t>(a.v) << N) };
+        }
+
+#if defined(GEKKO_NOISE_SSE2)
+        struct NoiseSse2 {
+            __m128i v;
+
+            static const size_t WIDTH = 4;
+
+            static NoiseSse2 Set(int32_t c) {
+                return { _mm_set1_epi32(c) };
+            }
+
+            static NoiseSse2 Load(const Unit* p) {
+                return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) };
+            }
+
+            void Store(Unit* p) const {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+            }
+
+            friend NoiseSse2 operator+(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_add_epi32(a.v, b.v) };
+            }
+
+            friend NoiseSse2 operator-(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_sub_epi32(a.v, b.v) };
+            }
+
+            // low 32 bits of the products; without SSE4.1 from two 32x32->64 multiplies
+            friend NoiseSse2 operator*(NoiseSse2 a, NoiseSse2 b) {
+#if defined(__SSE4_1__)
+                return { _mm_mullo_epi32(a.v, b.v) };
+#else
+                __m128i even = _mm_mul_epu32(a.v, b.v);
+                __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+                return { _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                    _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))) };
+#endif
+            }
+
+            friend NoiseSse2 operator&(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_and_si128(a.v, b.v) };
+            }
+
+            friend NoiseSse2 operator|(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_or_si128(a.v, b.v) };
+            }
+
+            friend NoiseSse2 operator^(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_xor_si128(a.v, b.v) };
+            }
+
+            friend NoiseSse2 Gt(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_cmpgt_epi32(a.v, b.v) };
+            }
+
+            friend NoiseSse2 Eq(NoiseSse2 a, NoiseSse2 b) {
+                return { _mm_cmpeq_epi32(a.v, b.v) };
+            }
+        };
+
+        template <int N>
+        NoiseSse2 Sra(NoiseSse2 a) {
+            return { _mm_srai_epi32(a.v, N) };
+        }
+
+        template <int N>
+        NoiseSse2 Srl(NoiseSse2 a) {
+            return { _mm_srli_epi32(a.v, N) };
+        }
+
+        template <int N>
+        NoiseSse2 Shl(NoiseSse2 a) {
+            return { _mm_slli_epi32(a.v, N) };
+        }
+
+#endif
+
+#if defined(GEKKO_NOISE_AVX2)
+        struct NoiseAvx2 {
+            __m256i v;
+
+            static const size_t WIDTH = 8;
+
+            static NoiseAvx2 Set(int32_t c) {
+                return { _mm256_set1_epi32(c) };
+            }
+
+            static NoiseAvx2 Load(const Unit* p) {
+                return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) };
+            }
+
+            void Store(Unit* p) const {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+            }
+
+            friend NoiseAvx2 operator+(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_add_epi32(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 operator-(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_sub_epi32(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 operator*(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_mullo_epi32(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 operator&(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_and_si256(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 operator|(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_or_si256(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 operator^(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_xor_si256(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 Gt(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_cmpgt_epi32(a.v, b.v) };
+            }
+
+            friend NoiseAvx2 Eq(NoiseAvx2 a, NoiseAvx2 b) {
+                return { _mm256_cmpeq_epi32(a.v, b.v) };
+            }
+        };
+
+        template <int N>
+        NoiseAvx2 Sra(NoiseAvx2 a) {
+            return { _mm256_srai_epi32(a.v, N) };
+        }
+
+        template <int N>
+        NoiseAvx2 Srl(NoiseAvx2 a) {
+            return { _mm256_srli_epi32(a.v, N) };
+        }
+
+        template <int N>
+        NoiseAvx2 Shl(NoiseAvx2 a) {
+            return { _mm256_slli_epi32(a.v, N) };
+        }
+
+#endif
+
+#if defined(GEKKO_NOISE_NEON)
+        struct NoiseNeon {
+            int32x4_t v;
+
+            static const size_t WIDTH = 4;
+
+            static NoiseNeon Set(int32_t c) {
+                return { vdupq_n_s32(c) };
+            }
+
+            static NoiseNeon Load(const Unit* p) {
+                return { vld1q_s32(reinterpret_cast<const int32_t*>(p)) };
+            }
+
+            void Store(Unit* p) const {
+                vst1q_s32(reinterpret_cast<int32_t*>(p), v);
+            }
+
+            friend NoiseNeon operator+(NoiseNeon a, NoiseNeon b) {
+                return { vaddq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon operator-(NoiseNeon a, NoiseNeon b) {
+                return { vsubq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon operator*(NoiseNeon a, NoiseNeon b) {
+                return { vmulq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon operator&(NoiseNeon a, NoiseNeon b) {
+                return { vandq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon operator|(NoiseNeon a, NoiseNeon b) {
+                return { vorrq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon operator^(NoiseNeon a, NoiseNeon b) {
+                return { veorq_s32(a.v, b.v) };
+            }
+
+            friend NoiseNeon Gt(NoiseNeon a, NoiseNeon b) {
+                return { vreinterpretq_s32_u32(vcgtq_s32(a.v, b.v)) };
+            }
+
+            friend NoiseNeon Eq(NoiseNeon a, NoiseNeon b) {
+                return { vreinterpretq_s32_u32(vceqq_s32(a.v, b.v)) };
+            }
+        };
+
+        template <int N>
+        NoiseNeon Sra(NoiseNeon a) {
+            return { vshrq_n_s32(a.v, N) };
+        }
+
+        template <int N>
+        NoiseNeon Srl(NoiseNeon a) {
+            return { vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.v), N)) };
+        }
+
+        template <int N>
+        NoiseNeon Shl(NoiseNeon a) {
+            return { vshlq_n_s32(a.v, N) };
+        }
+
+#endif
+
+        // helpers shared by every lane type
+
+        template <typename L>
+        L Not(L a) {
+            return a ^ L::Set(-1);
+        }
+
+        // a where the mask is set, b elsewhere
+        template <typename L>
+        L Select(L mask, L a, L b) {
+            return (mask & a) | (Not(mask) & b);
+        }
+
+        // -v where the mask is set
+        template <typename L>
+        L Negate(L v, L mask) {
+            return (v ^ mask) - mask;
+        }
+
+        template <typename L>
+        L Max0(L v) {
+            return Gt(v, L::Set(0)) & v;
+        }
+
+        // rounded product of two Q12 values
+        template <typename L>
+        L Mul12(L a, L b) {
+            return Sra<12>(a * b + L::Set(NOISE_ONE / 2));
+        }
+
+        template <typename L>
+        L Mix(L h) {
+            h = h ^ Srl<15>(h);
+            h = h * L::Set(static_cast<int32_t>(0x85EBCA77u));
+            h = h ^ Srl<13>(h);
+            h = h * L::Set(static_cast<int32_t>(0xC2B2AE35u));
+            return h ^ Srl<16>(h);
+        }
+
+        // per-axis hash multipliers; neighbouring cells add the constant instead of multiplying again
+        constexpr int32_t HASH_X = 0x27D4EB2D;
+        constexpr int32_t HASH_Y = 0x165667B1;
+        constexpr int32_t HASH_Z = static_cast<int32_t>(0x9E3779B1u);
+
+        // the top three hash bits pick one of (+-1, +-1), (+-1, 0), (0, +-1)
+        template <typename L>
+        L Grad(L h, L x, L y) {
+            L sign = Sra<31>(Shl<2>(h));
+            L second = Sra<31>(Shl<1>(h));
+            L axis = Sra<31>(h);
+            L diagonal = Negate(x, sign) + Negate(y, second);
+            L single = Negate(Select(second, y, x), sign);
+            return Select(axis, single, diagonal);
+        }
+
+        // the top four hash bits pick one of the 12 cube edge directions (+-u +-v), four of them twice
+        template <typename L>
+        L Grad(L h, L x, L y, L z) {
+            L su = Sra<31>(Shl<3>(h));
+            L sv = Sra<31>(Shl<2>(h));
+            L pair = Srl<30>(h);
+            L yz = Eq(pair, L::Set(2));
+            L xz = Eq(pair, L::Set(1));
+            L u = Select(yz, y, x);
+            L v = Select(xz | yz, z, y);
+            return Negate(u, su) + Negate(v, sv);
+        }
+
+        // 6t^5 - 15t^4 + 10t^3 on [0, 1) in Q12; t^3 is kept at 15 bits since the polynomial scales its error by up to 10
+        template <typename L>
+        L Fade(L t) {
+            L t2 = Sra<9>(t * t);
+            L t3 = Sra<12>(t2 * t);
+            L p = L::Set(10 * NOISE_ONE) + Mul12(t, t * L::Set(6) - L::Set(15 * NOISE_ONE));
+            return Sra<15>(t3 * p + L::Set(1 << 14));
+        }
+
+        template <typename L>
+        L Lerp(L a, L b, L t) {
+            return a + Mul12(b - a, t);
+        }
+
+        // whole units and the Q12 fraction of a raw Unit
+        template <typename L>
+        void Split(L raw, L& cell, L& frac) {
+            cell = Sra<15>(raw);
+            frac = Srl<3>(raw & L::Set(Unit::ONE - 1));
+        }
+
+        template <typename L>
+        L Perlin2(L x, L y, L seed) {
+            L xi, xf, yi, yf;
+            Split(x, xi, xf);
+            Split(y, yi, yf);
+            const L unit = L::Set(NOISE_ONE), ax = L::Set(HASH_X), ay = L::Set(HASH_Y);
+            L x1 = xf - unit, y1 = yf - unit;
+            L u = Fade(xf), v = Fade(yf);
+            L hx = xi * ax, hy0 = yi * ay, hy1 = hy0 + ay;
+            L hx0 = seed ^ hx, hx1 = seed ^ (hx + ax);
+            L n00 = Grad(Mix(hx0 ^ hy0), xf, yf);
+            L n10 = Grad(Mix(hx1 ^ hy0), x1, yf);
+            L n01 = Grad(Mix(hx0 ^ hy1), xf, y1);
+            L n11 = Grad(Mix(hx1 ^ hy1), x1, y1);
+            return Shl<3>(Lerp(Lerp(n00, n10, u), Lerp(n01, n11, u), v));
+        }
+
+        template <typename L>
+        L Perlin3(L x, L y, L z, L seed) {
+            L xi, xf, yi, yf, zi, zf;
+            Split(x, xi, xf);
+            Split(y, yi, yf);
+            Split(z, zi, zf);
+            const L unit = L::Set(NOISE_ONE), ax = L::Set(HASH_X), ay = L::Set(HASH_Y), az = L::Set(HASH_Z);
+            L x1 = xf - unit, y1 = yf - unit, z1 = zf - unit;
+            L u = Fade(xf), v = Fade(yf), w = Fade(zf);
+            L hx = xi * ax, hy0 = yi * ay, hy1 = hy0 + ay, hz0 = zi * az, hz1 = hz0 + az;
+            L hx0 = seed ^ hx, hx1 = seed ^ (hx + ax);
+            L n000 = Grad(Mix(hx0 ^ hy0 ^ hz0), xf, yf, zf);
+            L n100 = Grad(Mix(hx1 ^ hy0 ^ hz0), x1, yf, zf);
+            L n010 = Grad(Mix(hx0 ^ hy1 ^ hz0), xf, y1, zf);
+            L n110 = Grad(Mix(hx1 ^ hy1 ^ hz0), x1, y1, zf);
+            L n001 = Grad(Mix(hx0 ^ hy0 ^ hz1), xf, yf, z1);
+            L n101 = Grad(Mix(hx1 ^ hy0 ^ hz1), x1, yf, z1);
+            L n011 = Grad(Mix(hx0 ^ hy1 ^ hz1), xf, y1, z1);
+            L n111 = Grad(Mix(hx1 ^ hy1 ^ hz1), x1, y1, z1);
+            L nx00 = Lerp(n000, n100, u), nx10 = Lerp(n010, n110, u);
+            L nx01 = Lerp(n001, n101, u), nx11 = Lerp(n011, n111, u);
+            return Shl<3>(Lerp(Lerp(nx00, nx10, v), Lerp(nx01, nx11, v), w));
+        }
+
+        // skew factors (sqrt(3) - 1) / 2, (3 - sqrt(3)) / 6, 1/3 and 1/6 in Q12
+        constexpr int32_t SIMPLEX_F2 = 1499;
+        constexpr int32_t SIMPLEX_G2 = 866;
+        constexpr int32_t SIMPLEX_F3 = 1365;
+        constexpr int32_t SIMPLEX_G3 = 683;
+
+        // bring the peaks to just inside [-1, 1]
+        constexpr int32_t SIMPLEX_SCALE2 = 70;
+        constexpr int32_t SIMPLEX_SCALE3 = 76;
+
+        // (0.5 - r^2)^4 in Q16 times the gradient ramp in Q12; the sum keeps 28 fractional bits until it is scaled
+        template <typename L>
+        L Falloff(L r2) {
+            L t = Max0(L::Set(1 << 15) - r2);
+            L t2 = Sra<16>(t * t);
+            return Sra<16>(t2 * t2);
+        }
+
+        template <typename L>
+        L SimplexCorner(L h, L x, L y) {
+            return Falloff(Sra<8>(x * x) + Sra<8>(y * y)) * Grad(h, x, y);
+        }
+
+        template <typename L>
+        L SimplexCorner(L h, L x, L y, L z) {
+            return Falloff(Sra<8>(x * x) + Sra<8>(y * y) + Sra<8>(z * z)) * Grad(h, x, y, z);
+        }
+
+        // Q28 corner sum to a Unit
+        template <typename L>
+        L SimplexScale(L n, int32_t scale) {
+            return Sra<11>(Sra<2>(n) * L::Set(scale));
+        }
+
+        template <typename L>
+        L Simplex2(L x, L y, L seed) {
+            L xi, xf, yi, yf;
+            Split(x, xi, xf);
+            Split(y, yi, yf);
+            const L unit = L::Set(NOISE_ONE), g2 = L::Set(SIMPLEX_G2);
+            L xq = Shl<12>(xi) + xf, yq = Shl<12>(yi) + yf;
+
+            // skewed cell; the offset inside it is unskewed locally so large coordinates lose nothing
+            L s = (xi + yi) * L::Set(SIMPLEX_F2) + Mul12(xf + yf, L::Set(SIMPLEX_F2));
+            L sx = xq + s, sy = yq + s;
+            L i = Sra<12>(sx), j = Sra<12>(sy);
+            L u = sx & L::Set(NOISE_ONE - 1), v = sy & L::Set(NOISE_ONE - 1);
+            L t = Mul12(u + v, g2);
+            L x0 = u - t, y0 = v - t;
+
+            // the middle corner steps along x in the lower triangle, along y in the upper one
+            L lower = Gt(x0, y0);
+            L x1 = x0 - (lower & unit) + g2, y1 = y0 - (Not(lower) & unit) + g2;
+            L x2 = x0 - unit + g2 + g2, y2 = y0 - unit + g2 + g2;
+
+            const L ax = L::Set(HASH_X), ay = L::Set(HASH_Y);
+            L hx = i * ax, hy = j * ay;
+            L n = SimplexCorner(Mix(seed ^ hx ^ hy), x0, y0) +
+                SimplexCorner(Mix(seed ^ (hx + (lower & ax)) ^ (hy + (Not(lower) & ay))), x1, y1) +
+                SimplexCorner(Mix(seed ^ (hx + ax) ^ (hy + ay)), x2, y2);
+            return SimplexScale(n, SIMPLEX_SCALE2);
+        }
+
+        template <typename L>
+        L Simplex3(L x, L y, L z, L seed) {
+            L xi, xf, yi, yf, zi, zf;
+            Split(x, xi, xf);
+            Split(y, yi, yf);
+            Split(z, zi, zf);
+            const L unit = L::Set(NOISE_ONE), g3 = L::Set(SIMPLEX_G3);
+            L xq = Shl<12>(xi) + xf, yq = Shl<12>(yi) + yf, zq = Shl<12>(zi) + zf;
+
+            L s = (xi + yi + zi) * L::Set(SIMPLEX_F3) + Mul12(xf + yf + zf, L::Set(SIMPLEX_F3));
+            L sx = xq + s, sy = yq + s, sz = zq + s;
+            L i = Sra<12>(sx), j = Sra<12>(sy), k = Sra<12>(sz);
+            L u = sx & L::Set(NOISE_ONE - 1), v = sy & L::Set(NOISE_ONE - 1), w = sz & L::Set(NOISE_ONE - 1);
+            L t = Mul12(u + v + w, g3);
+            L x0 = u - t, y0 = v - t, z0 = w - t;
+
+            // which of the six tetrahedra: the second and third corners by the order of x0, y0, z0
+            L xy = Not(Gt(y0, x0)), yz = Not(Gt(z0, y0)), xz = Not(Gt(z0, x0));
+            L i1 = xy & xz, j1 = Not(xy) & yz, k1 = Not(xz | yz);
+            L i2 = xy | xz, j2 = Not(xy) | yz, k2 = Not(xz & yz);
+
+            L x1 = x0 - (i1 & unit) + g3, y1 = y0 - (j1 & unit) + g3, z1 = z0 - (k1 & unit) + g3;
+            L x2 = x0 - (i2 & unit) + g3 + g3, y2 = y0 - (j2 & unit) + g3 + g3, z2 = z0 - (k2 & unit) + g3 + g3;
+            L x3 = x0 - unit + g3 * L::Set(3), y3 = y0 - unit + g3 * L::Set(3), z3 = z0 - unit + g3 * L::Set(3);
+
+            const L ax = L::Set(HASH_X), ay = L::Set(HASH_Y), az = L::Set(HASH_Z);
+            L hx = i * ax, hy = j * ay, hz = k * az;
+            L n = SimplexCorner(Mix(seed ^ hx ^ hy ^ hz), x0, y0, z0) +
+                SimplexCorner(Mix(seed ^ (hx + (i1 & ax)) ^ (hy + (j1 & ay)) ^ (hz + (k1 & az))), x1, y1, z1) +
+                SimplexCorner(Mix(seed ^ (hx + (i2 & ax)) ^ (hy + (j2 & ay)) ^ (hz + (k2 & az))), x2, y2, z2) +
+                SimplexCorner(Mix(seed ^ (hx + ax) ^ (hy + ay) ^ (hz + az)), x3, y3, z3);
+            return SimplexScale(n, SIMPLEX_SCALE3);
+        }
+
+        // the widest lane type of the build
+#if defined(GEKKO_NOISE_AVX2)
+        using NoiseWide = NoiseAvx2;
+#elif defined(GEKKO_NOISE_SSE2)
+        using NoiseWide = NoiseSse2;
+#elif defined(GEKKO_NOISE_NEON)
+        using NoiseWide = NoiseNeon;
+#endif
+
+        struct Perlin2Kernel {
+            static const size_t D = 2;
+
+            template <typename L>
+            static L Run(const L* p, L seed) {
+                return Perlin2(p[0], p[1], seed);
+            }
+        };
+
+        struct Perlin3Kernel {
+            static const size_t D = 3;
+
+            template <typename L>
+            static L Run(const L* p, L seed) {
+                return Perlin3(p[0], p[1], p[2], seed);
+            }
+        };
+
+        struct Simplex2Kernel {
+            static const size_t D = 2;
+
+            template <typename L>
+            static L Run(const L* p, L seed) {
+                return Simplex2(p[0], p[1], seed);
+            }
+        };
+
+        struct Simplex3Kernel {
+            static const size_t D = 3;
+
+            template <typename L>
+            static L Run(const L* p, L seed) {
+                return Simplex3(p[0], p[1], p[2], seed);
+            }
+        };
+
+        template <typename K>
+        Unit Sample(const Unit* p, uint32_t seed) {
+            NoiseScalar lanes[K::D];
+            for (size_t d = 0; d < K::D; ++d) {
+                lanes[d] = NoiseScalar{ p[d].Raw() };
+            }
+            return Unit::From(K::Run(lanes, NoiseScalar{ static_cast<int32_t>(seed) }).v);
+        }
+
+        // SoA streams, WIDTH points per step and the rest one at a time
+        template <typename K>
+        void SampleBatch(const Unit* const* in, size_t count, Unit* out, uint32_t seed) {
+            size_t i = 0;
+#if defined(GEKKO_NOISE_AVX2) || defined(GEKKO_NOISE_SSE2) || defined(GEKKO_NOISE_NEON)
+            const NoiseWide s = NoiseWide::Set(static_cast<int32_t>(seed));
+            for (const size_t body = count & ~(NoiseWide::WIDTH - 1); i < body; i += NoiseWide::WIDTH) {
+                NoiseWide lanes[K::D];
+                for (size_t d = 0; d < K::D; ++d) {
+                    lanes[d] = NoiseWide::Load(in[d] + i);
+                }
+                K::Run(lanes, s).Store(out + i);
+            }
+#endif
+            for (; i < count; ++i) {
+                Unit p[K::D];
+                for (size_t d = 0; d < K::D; ++d) {
+                    p[d] = in[d][i];
+                }
+                out[i] = Sample<K>(p, seed);
+            }
+        }
+    }
+
+    // 2D Perlin noise, 0 at whole units
+    inline Unit Perlin(Unit x, Unit y, uint32_t seed = 0) {
+        const Unit p[2] = { x, y };
+        return Detail::Sample<Detail::Perlin2Kernel>(p, seed);
+    }
+
+    // 3D Perlin noise, 0 at whole units
+    inline Unit Perlin(const Vec3& v, uint32_t seed = 0) {
+        const Unit p[3] = { v.x, v.y, v.z };
+        return Detail::Sample<Detail::Perlin3Kernel>(p, seed);
+    }
+
+    inline Unit Simplex(Unit x, Unit y, uint32_t seed = 0) {
+        const Unit p[2] = { x, y };
+        return Detail::Sample<Detail::Simplex2Kernel>(p, seed);
+    }
+
+    inline Unit Simplex(const Vec3& v, uint32_t seed = 0) {
+        const Unit p[3] = { v.x, v.y, v.z };
+        return Detail::Sample<Detail::Simplex3Kernel>(p, seed);
+    }
+
+    // out[i] = Perlin(xs[i], ys[i], seed)
+    inline void Perlin(const Unit* xs, const Unit* ys, size_t count, Unit* out, uint32_t seed = 0) {
+        const Unit* const in[2] = { xs, ys };
+        Detail::SampleBatch<Detail::Perlin2Kernel>(in, count, out, seed);
+    }
+
+    // out[i] = Perlin(Vec3(xs[i], ys[i], zs[i]), seed)
+    inline void Perlin(const Unit* xs, const Unit* ys, const Unit* zs, size_t count, Unit* out, uint32_t seed = 0) {
+        const Unit* const in[3] = { xs, ys, zs };
+        Detail::SampleBatch<Detail::Perlin3Kernel>(in, count, out, seed);
+    }
+
+    inline void Simplex(const Unit* xs, const Unit* ys, size_t count, Unit* out, uint32_t seed = 0) {
+        const Unit* const in[2] = { xs, ys };
+        Detail::SampleBatch<Detail::Simplex2Kernel>(in, count, out, seed);
+    }
+
+    inline void Simplex(const Unit* xs, const Unit* ys, const Unit* zs, size_t count, Unit* out, uint32_t seed = 0) {
+        const Unit* const in[3] = { xs, ys, zs };
+        Detail::SampleBatch<Detail::Simplex3Kernel>(in, count, out, seed);
+    }
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "gekko_arena.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Deterministic data parallelism over index ranges (typically Unit/Vec3 arrays).
+//
+// [0, count) is split into chunks of 'grain' elements. The split depends only on count and grain,
+// never on the number of threads, and ParallelReduce combines the per-chunk partials in a fixed
+// pairwise tree on the calling thread: ((p0 + p1) + (p2 + p3)) + ... . The result is therefore
+// bit-identical for any worker count, including a pool with no workers, even when the combine
+// step rounds (Unit multiply, float add).
+//
+//     ThreadPool pool(std::thread::hardware_concurrency() - 1);
+//     ParallelFor(pool, n, 1024, [&](size_t begin, size_t end) { ... });
+//     Unit energy = ParallelReduce(pool, n, 1024, Unit(0),
+//         [&](size_t begin, size_t end) { Unit e = 0; for (...) e += ...; return e; },
+//         [](Unit a, Unit b) { return a + b; });
+//
+// Tasks must not throw and must not start another parallel call on the same pool. Partials live
+// in the calling thread's frame arena, so dispatching a job does not allocate.
+namespace Gekko::Math {
+
+    class ThreadPool {
+    public:
+        using Task = void (*)(void* context, uint32_t chunk);
+
+        // the calling thread always works too, so 0 workers runs everything inline
+        explicit ThreadPool(uint32_t workers) {
+            for (uint32_t i = 0; i < workers; ++i) {
+                _threads.emplace_back([this] { WorkerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wake.notify_all();
+            for (std::thread& t : _threads) {
+                t.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        uint32_t Workers() const {
+            return static_cast<uint32_t>(_threads.size());
+        }
+
+        // calls task(context, chunk) once for every chunk in [0, chunks), returns when all are done
+        void Run(uint32_t chunks, Task task, void* context) {
+            if (chunks == 0) {
+                return;
+            }
+            if (_threads.empty() || chunks == 1) {
+                for (uint32_t c = 0; c < chunks; ++c) {
+                    task(context, c);
+                }
+                return;
+            }
+
+            std::lock_guard<std::mutex> serial(_run);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task = task;
+                _context = context;
+                _chunks = chunks;
+                _next.store(0, std::memory_order_relaxed);
+                _busy = static_cast<uint32_t>(_threads.size());
+                _job++;
+            }
+            _wake.notify_all();
+
+            Work(task, context, chunks);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _busy == 0; });
+        }
+
+    private:
+        void Work(Task task, void* context, uint32_t chunks) {
+            for (uint32_t c = _next.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                 c = _next.fetch_add(1, std::memory_order_relaxed)) {
+                task(context, c);
+            }
+        }
+
+        void WorkerLoop() {
+            uint64_t seen = 0;
+            for (;;) {
+                Task task;
+                void* context;
+                uint32_t chunks;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wake.wait(lock, [&] { return _stop || _job != seen; });
+                    if (_stop) {
+                        return;
+                    }
+                    seen = _job;
+                    task = _task;
+                    context = _context;
+                    chunks = _chunks;
+                }
+                Work(task, context, chunks);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_busy == 0) {
+                        _done.notify_one();
+                    }
+                }
+            }
+        }
+
+        std::vector<std::thread> _threads;
+        std::mutex _run;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        std::atomic<uint32_t> _next{ 0 };
+        Task _task = nullptr;
+        void* _context = nullptr;
+        uint32_t _chunks = 0;
+        uint32_t _busy = 0;
+        uint64_t _job = 0;
+        bool _stop = false;
+    };
+
+    // number of chunks [0, count) is split into
+    inline uint32_t ChunkCount(size_t count, size_t grain) {
+        grain = grain ? grain : 1;
+        return static_cast<uint32_t>((count + grain - 1) / grain);
+    }
+
+    // fn(begin, end) for every chunk of 'grain' indices, in any order and on any thread
+    template <typename F>
+    void ParallelFor(ThreadPool& pool, size_t count, size_t grain, F&& fn) {
+        struct Context {
+            F* fn;
+            size_t count;
+            size_t grain;
+        };
+        grain = grain ? grain : 1;
+        Context ctx{ &fn, count, grain };
+        pool.Run(ChunkCount(count, grain), [](void* p, uint32_t chunk) {
+            Context& c = *static_cast<Context*>(p);
+            size_t begin = static_cast<size_t>(chunk) * c.grain;
+            size_t end = begin + c.grain < c.count ? begin + c.grain : c.count;
+            (*c.fn)(begin, end);
+        }, &ctx);
+    }
+
+    // combine(map(chunk 0), map(chunk 1), ...) in a fixed pairwise tree, identity for count == 0
+    template <typename T, typename Map, typename Combine>
+    T ParallelReduce(ThreadPool& pool, size_t count, size_t grain, const T& identity, Map&& map, Combine&& combine) {
+        static_assert(std::is_trivially_destructible<T>::value, "partials are kept in the frame arena");
+        const uint32_t chunks = ChunkCount(count, grain);
+        if (chunks == 0) {
+            return identity;
+        }
+
+        FrameArena& arena = ThreadArena();
+        ArenaScope scope(arena);
+        T* partials = arena.AllocateArray<T>(chunks);
+        if (!partials) {
+            return identity;
+        }
+
+        grain = grain ? grain : 1;
+        ParallelFor(pool, count, grain, [&](size_t begin, size_t end) {
+            new (&partials[begin / grain]) T(map(begin, end));
+        });
+
+        for (uint32_t step = 1; step < chunks; step *= 2) {
+            for (uint32_t i = 0; i + step < chunks; i += 2 * step) {
+                partials[i] = combine(partials[i], partials[i + step]);
+            }
+        }
+        return partials[0];
+    }
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Scoped profiling zones exported as Chrome trace JSON (chrome://tracing, Perfetto).
+//
+// GEKKO_PROFILE_ZONE("name") times the enclosing scope when GEKKO_MATH_PROFILE is defined and
+// compiles to nothing otherwise. Every thread writes into its own single-producer ring, an
+// aggregator thread drains the rings while recording, so a zone costs two timestamp reads and
+// one ring push. Names must be string literals: only the pointer is stored.
+//
+//     Gekko::Profile::Profiler::Get().Start();
+//     ... frames ...
+//     Gekko::Profile::Profiler::Get().Stop();
+//     Gekko::Profile::Profiler::Get().WriteChromeTrace("trace.json");
+#if defined(GEKKO_MATH_PROFILE)
+#define GEKKO_PROFILE_CONCAT_INNER(a, b) a##b
+#define GEKKO_PROFILE_CONCAT(a, b) GEKKO_PROFILE_CONCAT_INNER(a, b)
+#define GEKKO_PROFILE_ZONE(name) ::Gekko::Profile::Zone GEKKO_PROFILE_CONCAT(_gekko_zone_, __LINE__)(name)
+#else
+#define GEKKO_PROFILE_ZONE(name)
+#endif
+
+namespace Gekko::Profile {
+
+    // timestamp counter where available, steady_clock nanoseconds elsewhere
+    inline uint64_t ReadTicks() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    inline uint64_t NowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    struct Event {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    // lock-free ring with one producer (the owning thread) and one consumer (the aggregator)
+    class EventRing {
+    public:
+        static constexpr uint32_t CAPACITY = 1u << 14;
+
+        EventRing() : _events(new Event[CAPACITY]) {}
+
+        // drops the event when the aggregator has fallen a whole ring behind
+        bool Push(const Event& e) {
+            uint32_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            _events[head & (CAPACITY - 1)] = e;
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename Sink>
+        uint32_t Drain(Sink&& sink) {
+            uint32_t tail = _tail.load(std::memory_order_relaxed);
+            uint32_t head = _head.load(std::memory_order_acquire);
+            for (uint32_t i = tail; i != head; ++i) {
+                sink(_events[i & (CAPACITY - 1)]);
+            }
+            _tail.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        // events dropped since the last call
+        uint64_t TakeDropped() {
+            return _dropped.exchange(0, std::memory_order_relaxed);
+        }
+
+    private:
+        alignas(64) std::atomic<uint32_t> _head{ 0 };
+        alignas(64) std::atomic<uint32_t> _tail{ 0 };
+        std::atomic<uint64_t> _dropped{ 0 };
+        std::unique_ptr<Event[]> _events;
+    };
+
+    class Profiler {
+    public:
+        struct Record {
+            Event event;
+            uint32_t tid;
+        };
+
+        static Profiler& Get() {
+            static Profiler profiler;
+            return profiler;
+        }
+
+        ~Profiler() {
+            Stop();
+        }
+
+        // discards anything recorded before and starts the aggregator thread
+        void Start() {
+            std::lock_guard<std::mutex> control(_control);
+            if (_recording.load(std::memory_order_relaxed)) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto& buffer : _buffers) {
+                    buffer->ring.Drain([](const Event&) {});
+                    buffer->ring.TakeDropped();
+                }
+                // threads that exited have nothing left to push
+                _buffers.erase(std::remove_if(_buffers.begin(), _buffers.end(),
+                    [](const std::shared_ptr<ThreadBuffer>& b) { return b->retired.load(); }), _buffers.end());
+                _records.clear();
+                _dropped = 0;
+            }
+            _start_ticks = ReadTicks();
+            _start_ns = NowNs();
+            _stop_ticks = _start_ticks;
+            _stop_ns = _start_ns;
+            _recording.store(true, std::memory_order_release);
+            _aggregator = std::thread([this] {
+                while (_recording.load(std::memory_order_acquire)) {
+                    Collect();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+
+        // stops recording and collects what is still in the rings
+        void Stop() {
+            std::lock_guard<std::mutex> control(_control);
+            if (!_recording.load(std::memory_order_relaxed)) {
+                return;
+            }
+            _recording.store(false, std::memory_order_release);
+            _aggregator.join();
+            _stop_ticks = ReadTicks();
+            _stop_ns = NowNs();
+            Collect();
+        }
+
+        bool Recording() const {
+            return _recording.load(std::memory_order_relaxed);
+        }
+
+        // called from Zone, always on the recording thread
+        void Submit(const char* name, uint64_t begin, uint64_t end) {
+            LocalRing().Push(Event{ name, begin, end });
+        }
+
+        // collected records, stable once Stop returned
+        std::vector<Record> Records() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _records;
+        }
+
+        uint64_t Dropped() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _dropped;
+        }
+
+        // timestamp ticks per microsecond measured over the last recording
+        double TicksPerUs() const {
+            uint64_t ns = _stop_ns - _start_ns;
+            if (ns == 0) {
+                return 1000.0;
+            }
+            return static_cast<double>(_stop_ticks - _start_ticks) * 1000.0 / static_cast<double>(ns);
+        }
+
+        // complete ("X") events, one track per recording thread
+        bool WriteChromeTrace(const std::string& path) const {
+            std::FILE* f = std::fopen(path.c_str(), "w");
+            if (!f) {
+                std::fprintf(stderr, "cannot write %s\n", path.c_str());
+                return false;
+            }
+            std::vector<Record> records = Records();
+            std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+                return a.event.begin < b.event.begin;
+            });
+            const double per_us = TicksPerUs();
+            std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+            for (size_t i = 0; i < records.size(); ++i) {
+                const Record& r = records[i];
+                const double ts = static_cast<double>(r.event.begin - _start_ticks) / per_us;
+                const double dur = static_cast<double>(r.event.end - r.event.begin) / per_us;
+                std::fprintf(f, "%s\n{\"name\":\"", i ? "," : "");
+                for (const char* c = r.event.name; *c; ++c) {
+                    if (*c == '"' || *c == '\\') {
+                        std::fputc('\\', f);
+                    }
+                    std::fputc(*c, f);
+                }
+                std::fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", r.tid, ts, dur);
+            }
+            std::fprintf(f, "\n]}\n");
+            return std::fclose(f) == 0;
+        }
+
+    private:
+        struct ThreadBuffer {
+            uint32_t tid = 0;
+            std::atomic<bool> retired{ false };
+            EventRing ring;
+        };
+
+        // marks the buffer as retired when its thread exits, the profiler keeps it until drained
+        struct ThreadHandle {
+            std::shared_ptr<ThreadBuffer> buffer;
+
+            ~ThreadHandle() {
+                if (buffer) {
+                    buffer->retired.store(true);
+                }
+            }
+        };
+
+        Profiler() = default;
+
+        EventRing& LocalRing() {
+            thread_local ThreadHandle handle;
+            if (!handle.buffer) {
+                auto buffer = std::make_shared<ThreadBuffer>();
+                std::lock_guard<std::mutex> lock(_mutex);
+                buffer->tid = _next_tid++;
+                _buffers.push_back(buffer);
+                handle.buffer = buffer;
+            }
+            return handle.buffer->ring;
+        }
+
+        void Collect() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& buffer : _buffers) {
+                const uint32_t tid = buffer->tid;
+                buffer->ring.Drain([&](const Event& e) {
+                    _records.push_back(Record{ e, tid });
+                });
+                _dropped += buffer->ring.TakeDropped();
+            }
+        }
+
+        std::mutex _control;
+        mutable std::mutex _mutex;
+        std::atomic<bool> _recording{ false };
+        std::thread _aggregator;
+        std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+        std::vector<Record> _records;
+        uint64_t _dropped = 0;
+        uint32_t _next_tid = 1;
+        uint64_t _start_ticks = 0;
+        uint64_t _start_ns = 0;
+        uint64_t _stop_ticks = 0;
+        uint64_t _stop_ns = 0;
+    };
+
+    // times its scope if the profiler was recording when it was entered
+    class Zone {
+    public:
+        explicit Zone(const char* name)
+            : _name(name), _begin(Profiler::Get().Recording() ? ReadTicks() : 0) {}
+
+        ~Zone() {
+            if (_begin != 0) {
+                Profiler::Get().Submit(_name, _begin, ReadTicks());
+            }
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* _name;
+        uint64_t _begin;
+    };
+}
@@ -0,0 +1,489 @@
+#pragma once
+
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEKKO_RANDOM_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GEKKO_RANDOM_NEON 1
+#endif
+
+// Deterministic random numbers for gameplay, identical on every peer and platform.
+//
+// Random is xoshiro128**: 16 bytes of state, trivially copyable, so it goes into rollback
+// snapshots with the rest of the simulation and two generators compare with ==. Everything is
+// integer math on raw values; no floating point is involved anywhere.
+//
+//     Random rng(match_seed);
+//     Unit damage = rng.Range(Unit(10), Unit(20));         // [10, 20)
+//     Vec3 dir = rng.Direction();                          // length 1
+//
+// RandomBatch runs four independent xoshiro128** lanes side by side and fills arrays four values
+// per step with SSE2/NEON. Output i of a fill comes from lane i % 4, so a fill is exactly the
+// interleaving of the four lanes' scalar sequences and the vector and scalar builds agree.
+namespace Gekko::Math {
+
+    namespace Detail {
+        inline uint64_t SplitMix64(uint64_t& state) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        inline uint32_t Rotl(uint32_t x, int k) {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        // [lo, lo + width) from 32 random bits; bias below width / 2^32
+        inline int32_t MapRange(uint32_t bits, int32_t lo, uint32_t width) {
+            return static_cast<int32_t>(static_cast<uint32_t>(lo) + static_cast<uint32_t>((static_cast<uint64_t>(bits) * width) >> 32));
+        }
+
+        inline uint32_t Width(Unit lo, Unit hi) {
+            return hi > lo ? static_cast<uint32_t>(static_cast<int64_t>(hi.Raw()) - lo.Raw()) : 0;
+        }
+    }
+
+    class Random {
+    public:
+        Random() : Random(0) {}
+
+        explicit Random(uint64_t seed) {
+            Seed(seed);
+        }
+
+        void Seed(uint64_t seed) {
+            uint64_t sm = seed;
+            uint64_t a = Detail::SplitMix64(sm);
+            uint64_t b = Detail::SplitMix64(sm);
+            SetState(static_cast<uint32_t>(a), static_cast<uint32_t>(a >> 32), static_cast<uint32_t>(b), static_cast<uint32_t>(b >> 32));
+        }
+
+        // raw state, e.g. for a lane of RandomBatch; all zero is replaced by a fixed nonzero state
+        void SetState(uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3) {
+            _s[0] = s0;
+            _s[1] = s1;
+            _s[2] = s2;
+            _s[3] = s3;
+            if ((s0 | s1 | s2 | s3) == 0) {
+                _s[0] = 0x9E3779B9u;
+            }
+        }
+
+        uint32_t State(int i) const {
+            return _s[i];
+        }
+
+        uint32_t Next() {
+            const uint32_t result = Detail::Rotl(_s[1] * 5, 7) * 9;
+            const uint32_t t = _s[1] << 9;
+            _s[2] ^= _s[0];
+            _s[3] ^= _s[1];
+            _s[1] ^= _s[2];
+            _s[0] ^= _s[3];
+            _s[2] ^= t;
+            _s[3] = Detail::Rotl(_s[3], 11);
+            return result;
+        }
+
+        // [0, n), 0 for n == 0
+        uint32_t Below(uint32_t n) {
+            return static_cast<uint32_t>((static_cast<uint64_t>(Next()) * n) >> 32);
+        }
+
+        // [0, 1) in steps of one raw LSB
+        Unit NextUnit() {
+            return Unit::From(static_cast<int32_t>(Next() >> 17));
+        }
+
+        // [lo, hi), lo when the range is empty
+        Unit Range(Unit lo, Unit hi) {
+            return Unit::From(Detail::MapRange(Next(), lo.Raw(), Detail::Width(lo, hi)));
+        }
+
+        // uniform in the box [min, max) per axis
+        Vec3 InBox(const Vec3& min, const Vec3& max) {
+            Unit x = Range(min.x, max.x);
+            Unit y = Range(min.y, max.y);
+            Unit z = Range(min.z, max.z);
+            return Vec3(x, y, z);
+        }
+
+        // uniform in the ball of the given radius, by rejection from the cube [-1, 1)^3
+        Vec3 InSphere(Unit radius) {
+            for (;;) {
+                Vec3 v = Symmetric3();
+                if (v.Dot(v) <= Unit(1)) {
+                    return v * radius;
+                }
+            }
+        }
+
+        // uniform in the disc of the given radius in the xy plane, z is 0
+        Vec3 InDisc(Unit radius) {
+            for (;;) {
+                Unit x = Symmetric();
+                Unit y = Symmetric();
+                if (x * x + y * y <= Unit(1)) {
+                    return Vec3(x * radius, y * radius, Unit(0));
+                }
+            }
+        }
+
+        // uniform direction of length 1 (to within the precision of SqrtNewton); points too close
+        // to the center are rejected so the normalization stays accurate
+        Vec3 Direction() {
+            for (;;) {
+                Vec3 v = Symmetric3();
+                Unit d = v.Dot(v);
+                if (d <= Unit(1) && d >= Unit::From(Unit::ONE / 16)) {
+                    return v / Unit::SqrtNewton(d);
+                }
+            }
+        }
+
+        // approximately standard normal: the Irwin-Hall sum of 12 uniforms minus 6, within [-6, 6)
+        Unit Gaussian() {
+            int32_t sum = 0;
+            for (int i = 0; i < 12; ++i) {
+                sum += static_cast<int32_t>(Next() >> 17);
+            }
+            return Unit::From(sum - 6 * Unit::ONE);
+        }
+
+        Unit Gaussian(Unit mean, Unit stddev) {
+            return mean + Gaussian() * stddev;
+        }
+
+        bool operator==(const Random& other) const {
+            return _s[0] == other._s[0] && _s[1] == other._s[1] && _s[2] == other._s[2] && _s[3] == other._s[3];
+        }
+
+        bool operator!=(const Random& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        // [-1, 1)
+        Unit Symmetric() {
+            return Unit::From(static_cast<int32_t>(Next() >> 16) - Unit::ONE);
+        }
+
+        Vec3 Symmetric3() {
+            Unit x = Symmetric();
+            Unit y = Symmetric();
+            Unit z = Symmetric();
+            return Vec3(x, y, z);
+        }
+
+        uint32_t _s[4];
+    };
+
+    static_assert(std::is_trivially_copyable<Random>::value, "Random is part of rollback snapshots");
+
+    class RandomBatch {
+    public:
+        static const uint32_t LANES = 4;
+
+        RandomBatch() : RandomBatch(0) {}
+
+        // lane k is seeded from the splitmix64 sequence of 'seed', after the lanes before it
+        explicit RandomBatch(uint64_t seed) {
+            uint64_t sm = seed;
+            for (uint32_t k = 0; k < LANES; ++k) {
+                uint64_t a = Detail::SplitMix64(sm);
+                uint64_t b = Detail::SplitMix64(sm);
+                Random lane;
+                lane.SetState(static_cast<uint32_t>(a), static_cast<uint32_t>(a >> 32), static_cast<uint32_t>(b), static_cast<uint32_t>(b >> 32));
+                SetLane(k, lane);
+            }
+        }
+
+        // the scalar generator lane k currently is
+        Random Lane(uint32_t k) const {
+            Random r;
+            r.SetState(_s[0][k], _s[1][k], _s[2][k], _s[3][k]);
+            return r;
+        }
+
+        void SetLane(uint32_t k, const Random& r) {
+            for (int i = 0; i < 4; ++i) {
+                _s[i][k] = r.State(i);
+            }
+        }
+
+        // Every fill advances all lanes by whole steps: ceil(n / 4) steps (three per group of four
+        // vectors for InBox, twelve per group for Gaussian). Outputs past n are discarded.
+
+        void Fill(uint32_t* out, size_t count) {
+            Steps(count, [&](size_t i, size_t n, Block& b) {
+                uint32_t r[LANES];
+                b.Next(r);
+                for (size_t k = 0; k < n; ++k) {
+                    out[i + k] = r[k];
+                }
+            });
+        }
+
+        // [0, 1), as Random::NextUnit
+        void FillUnit(Unit* out, size_t count) {
+            Steps(count, [&](size_t i, size_t n, Block& b) {
+                int32_t r[LANES];
+                b.NextUnit(n == LANES ? Raw(out + i) : r);
+                Store(out + i, r, n);
+            });
+        }
+
+        // [lo, hi), as Random::Range
+        void FillRange(Unit* out, size_t count, Unit lo, Unit hi) {
+            const uint32_t width = Detail::Width(lo, hi);
+            Steps(count, [&](size_t i, size_t n, Block& b) {
+                int32_t r[LANES];
+                b.NextRange(n == LANES ? Raw(out + i) : r, lo.Raw(), width);
+                Store(out + i, r, n);
+            });
+        }
+
+        // per group of four vectors one step each for x, y and z
+        void FillInBox(Vec3* out, size_t count, const Vec3& min, const Vec3& max) {
+            const uint32_t wx = Detail::Width(min.x, max.x);
+            const uint32_t wy = Detail::Width(min.y, max.y);
+            const uint32_t wz = Detail::Width(min.z, max.z);
+            Steps(count, [&](size_t i, size_t n, Block& b) {
+                int32_t x[LANES], y[LANES], z[LANES];
+                b.NextRange(x, min.x.Raw(), wx);
+                b.NextRange(y, min.y.Raw(), wy);
+                b.NextRange(z, min.z.Raw(), wz);
+                for (size_t k = 0; k < n; ++k) {
+                    out[i + k] = Vec3(Unit::From(x[k]), Unit::From(y[k]), Unit::From(z[k]));
+                }
+            });
+        }
+
+        // as Random::Gaussian(mean, stddev), twelve steps per group of four
+        void FillGaussian(Unit* out, size_t count, Unit mean, Unit stddev) {
+            Steps(count, [&](size_t i, size_t n, Block& b) {
+                int32_t sum[LANES];
+                b.NextIrwinHall(sum);
+                for (size_t k = 0; k < n; ++k) {
+                    out[i + k] = mean + Unit::From(sum[k] - 6 * Unit::ONE) * stddev;
+                }
+            });
+        }
+
+        bool operator==(const RandomBatch& other) const {
+            for (int i = 0; i < 4; ++i) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    if (_s[i][k] != other._s[i][k]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const RandomBatch& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        static_assert(sizeof(Unit) == sizeof(int32_t), "full groups are written as raw values");
+
+        static int32_t* Raw(Unit* out) {
+            return reinterpret_cast<int32_t*>(out);
+        }
+
+        // a partial group at the end of a fill
+        static void Store(Unit* out, const int32_t* raw, size_t n) {
+            if (n == LANES) {
+                return;
+            }
+            for (size_t k = 0; k < n; ++k) {
+                out[k] = Unit::From(raw[k]);
+            }
+        }
+
+        // the four lanes, held in registers for the length of one fill
+        struct Block {
+#if defined(GEKKO_RANDOM_SSE2)
+            __m128i s0, s1, s2, s3;
+
+            explicit Block(const uint32_t (&s)[4][LANES]) {
+                s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s[0]));
+                s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s[1]));
+                s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s[2]));
+                s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s[3]));
+            }
+
+            void Save(uint32_t (&s)[4][LANES]) const {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(s[0]), s0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(s[1]), s1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(s[2]), s2);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(s[3]), s3);
+            }
+
+            static __m128i Rotl(__m128i x, int k) {
+                return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+            }
+
+            // x * 5 and x * 9 as shift-and-add, SSE2 has no 32-bit multiply
+            __m128i Step() {
+                __m128i r = Rotl(_mm_add_epi32(_mm_slli_epi32(s1, 2), s1), 7);
+                r = _mm_add_epi32(_mm_slli_epi32(r, 3), r);
+                const __m128i t = _mm_slli_epi32(s1, 9);
+                s2 = _mm_xor_si128(s2, s0);
+                s3 = _mm_xor_si128(s3, s1);
+                s1 = _mm_xor_si128(s1, s2);
+                s0 = _mm_xor_si128(s0, s3);
+                s2 = _mm_xor_si128(s2, t);
+                s3 = Rotl(s3, 11);
+                return r;
+            }
+
+            void Next(uint32_t* out) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), Step());
+            }
+
+            void NextUnit(int32_t* out) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_srli_epi32(Step(), 17));
+            }
+
+            // high halves of the 32x32 bit products, lanes 0 and 2 and lanes 1 and 3 separately
+            void NextRange(int32_t* out, int32_t lo, uint32_t width) {
+                const __m128i bits = Step();
+                const __m128i w = _mm_set1_epi32(static_cast<int32_t>(width));
+                const __m128i even = _mm_srli_epi64(_mm_mul_epu32(bits, w), 32);
+                const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(bits, 32), w);
+                const __m128i high = _mm_or_si128(even, _mm_and_si128(odd, _mm_set_epi32(-1, 0, -1, 0)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi32(high, _mm_set1_epi32(lo)));
+            }
+
+            void NextIrwinHall(int32_t* out) {
+                __m128i sum = _mm_setzero_si128();
+                for (int i = 0; i < 12; ++i) {
+                    sum = _mm_add_epi32(sum, _mm_srli_epi32(Step(), 17));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sum);
+            }
+#elif defined(GEKKO_RANDOM_NEON)
+            uint32x4_t s0, s1, s2, s3;
+
+            explicit Block(const uint32_t (&s)[4][LANES]) {
+                s0 = vld1q_u32(s[0]);
+                s1 = vld1q_u32(s[1]);
+                s2 = vld1q_u32(s[2]);
+                s3 = vld1q_u32(s[3]);
+            }
+
+            void Save(uint32_t (&s)[4][LANES]) const {
+                vst1q_u32(s[0], s0);
+                vst1q_u32(s[1], s1);
+                vst1q_u32(s[2], s2);
+                vst1q_u32(s[3], s3);
+            }
+
+            uint32x4_t Step() {
+                uint32x4_t x = vmulq_n_u32(s1, 5);
+                uint32x4_t r = vmulq_n_u32(vorrq_u32(vshlq_n_u32(x, 7), vshrq_n_u32(x, 25)), 9);
+                const uint32x4_t t = vshlq_n_u32(s1, 9);
+                s2 = veorq_u32(s2, s0);
+                s3 = veorq_u32(s3, s1);
+                s1 = veorq_u32(s1, s2);
+                s0 = veorq_u32(s0, s3);
+                s2 = veorq_u32(s2, t);
+                s3 = vorrq_u32(vshlq_n_u32(s3, 11), vshrq_n_u32(s3, 21));
+                return r;
+            }
+
+            void Next(uint32_t* out) {
+                vst1q_u32(out, Step());
+            }
+
+            void NextUnit(int32_t* out) {
+                vst1q_s32(out, vreinterpretq_s32_u32(vshrq_n_u32(Step(), 17)));
+            }
+
+            void NextRange(int32_t* out, int32_t lo, uint32_t width) {
+                const uint32x4_t bits = Step();
+                const uint32x2_t w = vdup_n_u32(width);
+                const uint32x4_t high = vcombine_u32(vshrn_n_u64(vmull_u32(vget_low_u32(bits), w), 32),
+                    vshrn_n_u64(vmull_u32(vget_high_u32(bits), w), 32));
+                vst1q_s32(out, vreinterpretq_s32_u32(vaddq_u32(high, vdupq_n_u32(static_cast<uint32_t>(lo)))));
+            }
+
+            void NextIrwinHall(int32_t* out) {
+                uint32x4_t sum = vdupq_n_u32(0);
+                for (int i = 0; i < 12; ++i) {
+                    sum = vaddq_u32(sum, vshrq_n_u32(Step(), 17));
+                }
+                vst1q_s32(out, vreinterpretq_s32_u32(sum));
+            }
+#else
+            Random lanes[LANES];
+
+            explicit Block(const uint32_t (&s)[4][LANES]) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    lanes[k].SetState(s[0][k], s[1][k], s[2][k], s[3][k]);
+                }
+            }
+
+            void Save(uint32_t (&s)[4][LANES]) const {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    for (int i = 0; i < 4; ++i) {
+                        s[i][k] = lanes[k].State(i);
+                    }
+                }
+            }
+
+            void Next(uint32_t* out) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    out[k] = lanes[k].Next();
+                }
+            }
+
+            void NextUnit(int32_t* out) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    out[k] = static_cast<int32_t>(lanes[k].Next() >> 17);
+                }
+            }
+
+            void NextRange(int32_t* out, int32_t lo, uint32_t width) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    out[k] = Detail::MapRange(lanes[k].Next(), lo, width);
+                }
+            }
+
+            void NextIrwinHall(int32_t* out) {
+                for (uint32_t k = 0; k < LANES; ++k) {
+                    int32_t sum = 0;
+                    for (int i = 0; i < 12; ++i) {
+                        sum += static_cast<int32_t>(lanes[k].Next() >> 17);
+                    }
+                    out[k] = sum;
+                }
+            }
+#endif
+        };
+
+        // fn(first index, outputs in this group, block) per group of four
+        template <typename F>
+        void Steps(size_t count, F&& fn) {
+            Block b(_s);
+            for (size_t i = 0; i < count; i += LANES) {
+                fn(i, count - i < LANES ? count - i : LANES, b);
+            }
+            b.Save(_s);
+        }
+
+        uint32_t _s[4][LANES];   // state word i of lane k at [i][k]
+    };
+
+    static_assert(std::is_trivially_copyable<RandomBatch>::value, "RandomBatch is part of rollback snapshots");
+}
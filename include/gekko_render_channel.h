@@ -0,0 +1,101 @@
+#pragma once
+
+#include "gekko_math_convert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// VISUALIZATION ONLY
+// Lock-free hand-off of Vec3F frames from the simulation thread to the render thread.
+//
+// A triple buffer: the producer fills the back buffer and publishes it by swapping it with the
+// middle one, the consumer takes the middle one when it is newer than what it holds. Neither side
+// ever waits for the other; the consumer always sees the latest complete frame and frames the
+// renderer was too slow for are skipped. Exactly one producer and one consumer thread.
+//
+//     // simulation thread, once per tick
+//     channel.Publish(positions.data(), positions.size(), tick);
+//
+//     // render thread, once per frame
+//     if (const RenderChannel::Frame* f = channel.Acquire()) { draw f->data[0 .. f->count) }
+namespace Gekko::Math {
+
+    class RenderChannel {
+    public:
+        struct Frame {
+            Vec3F* data = nullptr;
+            size_t count = 0;
+            uint64_t id = 0;
+        };
+
+        // every buffer holds up to 'capacity' vectors, allocated once here
+        explicit RenderChannel(size_t capacity) : _capacity(capacity) {
+            for (Buffer& b : _buffers) {
+                b.storage.reset(new Vec3F[capacity]);
+                b.frame.data = b.storage.get();
+            }
+        }
+
+        RenderChannel(const RenderChannel&) = delete;
+        RenderChannel& operator=(const RenderChannel&) = delete;
+
+        size_t Capacity() const {
+            return _capacity;
+        }
+
+        // producer: the buffer to fill, not visible to the consumer until Publish
+        Frame& Back() {
+            return _buffers[_back].frame;
+        }
+
+        // producer: hands the back buffer over and takes the old middle one as the new back buffer
+        void Publish() {
+            uint32_t previous = _state.exchange(_back | FRESH, std::memory_order_acq_rel);
+            _back = previous & INDEX;
+        }
+
+        // producer: converts 'count' positions into the back buffer and publishes them, count is
+        // clamped to the capacity
+        void Publish(const Vec3* positions, size_t count, uint64_t id) {
+            Frame& f = Back();
+            f.count = count < _capacity ? count : _capacity;
+            f.id = id;
+            AsFloat(positions, f.count, f.data);
+            Publish();
+        }
+
+        // consumer: the newest published frame, or the one it already held if nothing new arrived;
+        // nullptr before the first Publish. Valid until the next Acquire.
+        const Frame* Acquire() {
+            if (_state.load(std::memory_order_relaxed) & FRESH) {
+                uint32_t previous = _state.exchange(_front, std::memory_order_acq_rel);
+                _front = previous & INDEX;
+                _has_front = true;
+            }
+            return _has_front ? &_buffers[_front].frame : nullptr;
+        }
+
+        // consumer: true when a frame newer than the held one is waiting
+        bool HasNew() const {
+            return (_state.load(std::memory_order_relaxed) & FRESH) != 0;
+        }
+
+    private:
+        static constexpr uint32_t INDEX = 3;
+        static constexpr uint32_t FRESH = 4;
+
+        struct alignas(64) Buffer {
+            std::unique_ptr<Vec3F[]> storage;
+            Frame frame;
+        };
+
+        Buffer _buffers[3];
+        size_t _capacity;
+        alignas(64) std::atomic<uint32_t> _state{ 1 };   // middle index, FRESH when unread
+        alignas(64) uint32_t _back = 0;                  // producer only
+        alignas(64) uint32_t _front = 2;                 // consumer only
+        bool _has_front = false;
+    };
+}
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "gekko_keyframes.h"
+#include "gekko_math_core.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Cubic splines over Vec3 for rails, projectile paths and other gameplay curves.
+//
+// A Spline is a view over control points, either piecewise cubic Bezier (3n + 1 points, segment i
+// uses points 3i..3i+3) or uniform Catmull-Rom through every point (the end points are repeated
+// for the end tangents). The parameter runs from 0 to Segments(), one unit per segment.
+//
+//     Spline rail(points, count, SplineKind::CatmullRom);
+//     Vec3 p = rail.Evaluate(s);
+//     rail.Tessellate(steps, out);                            // Segments() * steps + 1 points
+//     ArcLengthTable table(rail, 16, lengths);                // lengths[ArcLengthTable::Entries(rail, 16)]
+//     Vec3 q = rail.Evaluate(table.Parameter(distance, cursor));
+//     Unit nearest = rail.Closest(position);
+//
+// Each segment is kept as an integer cubic in raw units over a power-of-two denominator (1 for
+// Bezier, 2 for Catmull-Rom), so both kinds hit their end points exactly. Tessellate runs exact
+// integer forward differences on that cubic at k / steps and rounds each point once: there is no
+// drift along the segment, and the cost is three additions and a shift per coordinate. Evaluate is
+// a rounded Horner step per power and agrees with Tessellate to within an LSB or two.
+namespace Gekko::Math {
+
+    enum class SplineKind : uint8_t {
+        Bezier,
+        CatmullRom,
+    };
+
+    namespace Detail {
+        // x / 2^n rounded half up
+        inline int64_t RoundShift(int64_t x, int n) {
+            return n == 0 ? x : (x + (int64_t(1) << (n - 1))) >> n;
+        }
+
+        // x / d rounded half up, d > 0
+        inline int64_t RoundDiv(int64_t x, int64_t d) {
+            int64_t n = x + d / 2;
+            int64_t q = n / d;
+            return q * d > n ? q - 1 : q;
+        }
+
+        // a u^3 + b u^2 + c u + d per coordinate, over 2^shift
+        struct SplineCubic {
+            int64_t a[3], b[3], c[3], d[3];
+            int shift;
+        };
+
+        inline int64_t Raw(const Vec3& v, int i) {
+            return (i == 0 ? v.x : (i == 1 ? v.y : v.z)).Raw();
+        }
+
+        inline Vec3 FromRaw(const int64_t (&v)[3]) {
+            return Vec3(Unit::From(static_cast<int32_t>(v[0])), Unit::From(static_cast<int32_t>(v[1])), Unit::From(static_cast<int32_t>(v[2])));
+        }
+
+        // squared distance in raw units, a quarter of it so three terms fit
+        inline uint64_t Distance2(const Vec3& a, const Vec3& b) {
+            uint64_t sum = 0;
+            for (int i = 0; i < 3; ++i) {
+                const int64_t d = Raw(a, i) - Raw(b, i);
+                sum += (static_cast<uint64_t>(d) * static_cast<uint64_t>(d)) >> 2;
+            }
+            return sum;
+        }
+    }
+
+    class Spline {
+    public:
+        // forward differencing keeps k^3 * steps^0..3 terms in 64 bits up to this many steps per segment
+        static const uint32_t MAX_STEPS = 256;
+
+        Spline() = default;
+
+        // 'points' must outlive the spline
+        Spline(const Vec3* points, uint32_t count, SplineKind kind) : _points(points), _count(count), _kind(kind) {
+            const bool valid = kind == SplineKind::Bezier ? count >= 4 && count % 3 == 1 : count >= 2;
+            if (!valid) {
+                GEKKO_MATH_ERROR("Bezier splines need 3n + 1 points, Catmull-Rom at least 2");
+                _count = 0;
+            }
+        }
+
+        SplineKind Kind() const {
+            return _kind;
+        }
+
+        uint32_t Segments() const {
+            if (_count == 0) {
+                return 0;
+            }
+            return _kind == SplineKind::Bezier ? (_count - 1) / 3 : _count - 1;
+        }
+
+        // point at parameter s, clamped to [0, Segments()]
+        Vec3 Evaluate(Unit s) const {
+            if (_count == 0) {
+                return Vec3(Unit(0), Unit(0), Unit(0));
+            }
+            int32_t u;
+            const Detail::SplineCubic cubic = Cubic(Locate(s, u));
+            int64_t p[3];
+            for (int i = 0; i < 3; ++i) {
+                int64_t v = Detail::RoundShift(cubic.a[i] * u, 15) + cubic.b[i];
+                v = Detail::RoundShift(v * u, 15) + cubic.c[i];
+                v = Detail::RoundShift(v * u, 15) + cubic.d[i];
+                p[i] = Detail::RoundShift(v, cubic.shift);
+            }
+            return Detail::FromRaw(p);
+        }
+
+        // derivative at s, per unit of parameter
+        Vec3 Tangent(Unit s) const {
+            if (_count == 0) {
+                return Vec3(Unit(0), Unit(0), Unit(0));
+            }
+            int32_t u;
+            const Detail::SplineCubic cubic = Cubic(Locate(s, u));
+            int64_t p[3];
+            for (int i = 0; i < 3; ++i) {
+                int64_t v = Detail::RoundShift(3 * cubic.a[i] * u, 15) + 2 * cubic.b[i];
+                v = Detail::RoundShift(v * u, 15) + cubic.c[i];
+                p[i] = Detail::RoundShift(v, cubic.shift);
+            }
+            return Detail::FromRaw(p);
+        }
+
+        // out[i] = Evaluate(params[i])
+        void Evaluate(const Unit* params, size_t count, Vec3* out) const {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Evaluate(params[i]);
+            }
+        }
+
+        // steps + 1 points of one segment at k / steps, steps in [1, MAX_STEPS]
+        void Tessellate(uint32_t segment, uint32_t steps, Vec3* out) const {
+            if (steps == 0 || steps > MAX_STEPS || segment >= Segments()) {
+                GEKKO_MATH_ERROR("Tessellate needs 1 to 256 steps of an existing segment");
+                return;
+            }
+            const Detail::SplineCubic cubic = Cubic(segment);
+            const int64_t n = steps, n2 = n * n, n3 = n2 * n;
+            int log2 = 0;
+            while ((uint32_t(1) << log2) < steps) {
+                ++log2;
+            }
+            const bool pow2 = (uint32_t(1) << log2) == steps;
+            const int shift = 3 * log2 + cubic.shift;
+            const int64_t den = n3 << cubic.shift;
+
+            // Q(k) = a k^3 + b n k^2 + c n^2 k + d n^3 and its forward differences, all exact
+            int64_t q[3], d1[3], d2[3], d3[3];
+            for (int i = 0; i < 3; ++i) {
+                q[i] = cubic.d[i] * n3;
+                d1[i] = cubic.a[i] + cubic.b[i] * n + cubic.c[i] * n2;
+                d2[i] = 6 * cubic.a[i] + 2 * cubic.b[i] * n;
+                d3[i] = 6 * cubic.a[i];
+            }
+            for (uint32_t k = 0; k <= steps; ++k) {
+                int64_t p[3];
+                for (int i = 0; i < 3; ++i) {
+                    p[i] = pow2 ? Detail::RoundShift(q[i], shift) : Detail::RoundDiv(q[i], den);
+                    q[i] += d1[i];
+                    d1[i] += d2[i];
+                    d2[i] += d3[i];
+                }
+                out[k] = Detail::FromRaw(p);
+            }
+        }
+
+        // Segments() * steps + 1 points along the whole spline
+        void Tessellate(uint32_t steps, Vec3* out) const {
+            for (uint32_t s = 0; s < Segments(); ++s) {
+                Tessellate(s, steps, out + static_cast<size_t>(s) * steps);
+            }
+        }
+
+        // parameter of the point nearest to p: the closest of 'steps' samples per segment, then
+        // a bisecting search around it down to one LSB of the parameter
+        Unit Closest(const Vec3& p, uint32_t steps = 16) const {
+            const uint32_t segments = Segments();
+            if (segments == 0 || steps == 0 || steps > MAX_STEPS) {
+                return Unit(0);
+            }
+            Vec3 samples[MAX_STEPS + 1];
+            uint64_t best = UINT64_MAX;
+            int64_t at = 0;
+            for (uint32_t s = 0; s < segments; ++s) {
+                Tessellate(s, steps, samples);
+                for (uint32_t k = 0; k <= steps; ++k) {
+                    const uint64_t d = Detail::Distance2(samples[k], p);
+                    if (d < best) {
+                        best = d;
+                        at = static_cast<int64_t>(s) * Unit::ONE + Detail::RoundDiv(static_cast<int64_t>(k) * Unit::ONE, steps);
+                    }
+                }
+            }
+            const int64_t end = static_cast<int64_t>(segments) * Unit::ONE;
+            for (int64_t h = Unit::ONE / steps; h > 0; h /= 2) {
+                const int64_t lo = at - h < 0 ? 0 : at - h, hi = at + h > end ? end : at + h;
+                const uint64_t dlo = Detail::Distance2(Evaluate(Unit::From(static_cast<int32_t>(lo))), p);
+                const uint64_t dhi = Detail::Distance2(Evaluate(Unit::From(static_cast<int32_t>(hi))), p);
+                if (dlo < best && dlo <= dhi) {
+                    best = dlo;
+                    at = lo;
+                }
+                else if (dhi < best) {
+                    best = dhi;
+                    at = hi;
+                }
+            }
+            return Unit::From(static_cast<int32_t>(at));
+        }
+
+    private:
+        // segment of s and the raw position u in [0, ONE] inside it
+        uint32_t Locate(Unit s, int32_t& u) const {
+            const uint32_t segments = Segments();
+            if (s.Raw() <= 0) {
+                u = 0;
+                return 0;
+            }
+            const uint32_t segment = static_cast<uint32_t>(s.Raw() >> 15);
+            if (segment >= segments) {
+                u = Unit::ONE;
+                return segments - 1;
+            }
+            u = s.Raw() & (Unit::ONE - 1);
+            return segment;
+        }
+
+        Detail::SplineCubic Cubic(uint32_t segment) const {
+            Detail::SplineCubic cubic;
+            if (_kind == SplineKind::Bezier) {
+                const Vec3* p = _points + 3 * segment;
+                cubic.shift = 0;
+                for (int i = 0; i < 3; ++i) {
+                    const int64_t p0 = Detail::Raw(p[0], i), p1 = Detail::Raw(p[1], i), p2 = Detail::Raw(p[2], i), p3 = Detail::Raw(p[3], i);
+                    cubic.a[i] = p3 - 3 * p2 + 3 * p1 - p0;
+                    cubic.b[i] = 3 * (p0 - 2 * p1 + p2);
+                    cubic.c[i] = 3 * (p1 - p0);
+                    cubic.d[i] = p0;
+                }
+                return cubic;
+            }
+            const Vec3& q0 = _points[segment == 0 ? 0 : segment - 1];
+            const Vec3& q1 = _points[segment];
+            const Vec3& q2 = _points[segment + 1];
+            const Vec3& q3 = _points[segment + 2 < _count ? segment + 2 : _count - 1];
+            cubic.shift = 1;
+            for (int i = 0; i < 3; ++i) {
+                const int64_t p0 = Detail::Raw(q0, i), p1 = Detail::Raw(q1, i), p2 = Detail::Raw(q2, i), p3 = Detail::Raw(q3, i);
+                cubic.a[i] = -p0 + 3 * p1 - 3 * p2 + p3;
+                cubic.b[i] = 2 * p0 - 5 * p1 + 4 * p2 - p3;
+                cubic.c[i] = p2 - p0;
+                cubic.d[i] = 2 * p1;
+            }
+            return cubic;
+        }
+
+        const Vec3* _points = nullptr;
+        uint32_t _count = 0;
+        SplineKind _kind = SplineKind::Bezier;
+    };
+
+    // Cumulative chord lengths of a tessellated spline, for travel at constant speed: distance along
+    // the curve maps back to a spline parameter by interpolating between the samples. The cursor
+    // works as on a KeyTrack, so a follower that advances a little each tick does no search.
+    class ArcLengthTable {
+    public:
+        static uint32_t Entries(const Spline& spline, uint32_t steps) {
+            return spline.Segments() * steps + 1;
+        }
+
+        ArcLengthTable() = default;
+
+        // fills lengths[Entries(spline, steps)]; the spline's points and 'lengths' must outlive the table
+        ArcLengthTable(const Spline& spline, uint32_t steps, Unit* lengths) : _spline(spline), _lengths(lengths), _steps(steps) {
+            const uint32_t segments = spline.Segments();
+            if (segments == 0 || steps == 0 || steps > Spline::MAX_STEPS) {
+                GEKKO_MATH_ERROR("ArcLengthTable needs a spline and 1 to 256 steps");
+                return;
+            }
+            Vec3 samples[Spline::MAX_STEPS + 1];
+            Unit total = Unit(0);
+            lengths[0] = total;
+            for (uint32_t s = 0; s < segments; ++s) {
+                spline.Tessellate(s, steps, samples);
+                for (uint32_t k = 1; k <= steps; ++k) {
+                    // chords are short, so the squared raw length fits 64 bits exactly
+                    uint64_t d2 = 0;
+                    for (int i = 0; i < 3; ++i) {
+                        const int64_t d = Detail::Raw(samples[k], i) - Detail::Raw(samples[k - 1], i);
+                        d2 += static_cast<uint64_t>(d * d);
+                    }
+                    uint64_t root = Detail::ISqrt(d2);
+                    root += d2 - root * root > root ? 1 : 0;
+                    total += Unit::From(static_cast<int32_t>(root));
+                    lengths[s * steps + k] = total;
+                }
+            }
+            _entries = segments * steps + 1;
+        }
+
+        Unit Length() const {
+            return _entries == 0 ? Unit(0) : _lengths[_entries - 1];
+        }
+
+        // spline parameter at 'distance' along the curve, clamped to [0, Length()]
+        Unit Parameter(Unit distance, TrackCursor& cursor) const {
+            if (_entries < 2) {
+                return Unit(0);
+            }
+            const Unit* lengths = _lengths;
+            const uint32_t i = Detail::Locate([lengths](uint32_t k) { return lengths[k]; }, _entries, distance, cursor.segment);
+            cursor.segment = i;
+            const Unit l0 = lengths[i], l1 = lengths[i + 1];
+            int64_t frac = 0;
+            if (distance >= l1) {
+                frac = Unit::ONE;
+            }
+            else if (distance > l0) {
+                frac = (distance - l0).Raw() * static_cast<int64_t>(Unit::ONE) / (l1 - l0).Raw();
+            }
+            return Unit::From(static_cast<int32_t>(Detail::RoundDiv(static_cast<int64_t>(i) * Unit::ONE + frac, _steps)));
+        }
+
+        Unit Parameter(Unit distance) const {
+            TrackCursor cursor;
+            return Parameter(distance, cursor);
+        }
+
+        // point at 'distance' along the curve
+        Vec3 Evaluate(Unit distance, TrackCursor& cursor) const {
+            return _spline.Evaluate(Parameter(distance, cursor));
+        }
+
+    private:
+        Spline _spline;
+        const Unit* _lengths = nullptr;
+        uint32_t _entries = 0;
+        uint32_t _steps = 1;
+    };
+}
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "gekko_math_convert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GEKKO_STATE_EXPORT_POSIX 1
+#endif
+
+// Zero-copy export of simulation state to local tools (visualizers, analytics) in other processes.
+//
+// The state lives in a ring of frame slots in one memory block, normally POSIX shared memory. Each
+// slot holds the positions as raw Unit streams x, y, z plus their float projections, and a sequence
+// number: a seqlock that is odd while the slot is written. The simulation thread never waits on a
+// reader; readers look at the newest slot in place and call Validate afterwards, a slot is only
+// overwritten after the writer has gone once around the ring.
+//
+//     // simulation process
+//     SharedMemory shm = SharedMemory::Create("/gekko_state", StateExport::Bytes(4, count));
+//     StateExport out(shm.Data(), shm.Size(), 4, count);
+//     out.Publish(positions, count, tick);                          // every tick
+//
+//     // visualizer process
+//     SharedMemory shm = SharedMemory::Open("/gekko_state");
+//     StateView in(shm.Data(), shm.Size());
+//     in.Read([&](const StateFrame& f) { draw f.fx, f.fy, f.fz [0 .. f.count) });
+//
+// One writer; any number of readers, which only ever read the block. Readers must treat whatever
+// they saw as garbage unless Validate (or Read) confirms it.
+namespace Gekko::Math {
+
+    // a frame as seen by a reader, pointing into the shared block
+    struct StateFrame {
+        uint64_t id = 0;
+        uint32_t count = 0;
+        const int32_t* x = nullptr;
+        const int32_t* y = nullptr;
+        const int32_t* z = nullptr;
+        const float* fx = nullptr;
+        const float* fy = nullptr;
+        const float* fz = nullptr;
+        uint32_t slot = 0;
+        uint32_t sequence = 0;
+    };
+
+    namespace Detail {
+        static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+            "the shared block needs address-free atomics");
+
+        constexpr uint32_t STATE_MAGIC = 0x47534531;   // "GSE1"
+        constexpr uint32_t STATE_VERSION = 1;
+        constexpr size_t STATE_ALIGN = 64;
+
+        inline size_t AlignUp(size_t bytes) {
+            return (bytes + STATE_ALIGN - 1) & ~(STATE_ALIGN - 1);
+        }
+
+        struct alignas(STATE_ALIGN) StateHeader {
+            std::atomic<uint32_t> magic;               // written last by the creator
+            uint32_t version;
+            uint32_t slots;
+            uint32_t capacity;
+            uint64_t slot_bytes;
+            alignas(STATE_ALIGN) std::atomic<uint64_t> published;   // frames published so far
+        };
+
+        struct alignas(STATE_ALIGN) StateSlot {
+            std::atomic<uint32_t> sequence;            // odd while the writer is inside
+            std::atomic<uint32_t> count;
+            std::atomic<uint64_t> id;
+        };
+
+        // per slot: the slot header, then x, y, z raw and x, y, z float, each stream 64-byte aligned
+        inline size_t StreamBytes(uint32_t capacity) {
+            return AlignUp(sizeof(int32_t) * capacity);
+        }
+
+        inline size_t SlotBytes(uint32_t capacity) {
+            return sizeof(StateSlot) + 6 * StreamBytes(capacity);
+        }
+
+        inline StateSlot* SlotAt(unsigned char* base, const StateHeader& h, uint64_t frame) {
+            return reinterpret_cast<StateSlot*>(base + sizeof(StateHeader) + (frame % h.slots) * h.slot_bytes);
+        }
+
+        inline unsigned char* StreamAt(StateSlot* slot, uint32_t capacity, int stream) {
+            return reinterpret_cast<unsigned char*>(slot) + sizeof(StateSlot) + stream * StreamBytes(capacity);
+        }
+    }
+
+    // the writing side, owned by the simulation
+    class StateExport {
+    public:
+        // size of a block for 'slots' frames of up to 'capacity' positions
+        static size_t Bytes(uint32_t slots, uint32_t capacity) {
+            return sizeof(Detail::StateHeader) + static_cast<size_t>(slots) * Detail::SlotBytes(capacity);
+        }
+
+        // formats 'memory' as an empty ring; the block must be 64-byte aligned, as mappings are
+        StateExport(void* memory, size_t bytes, uint32_t slots, uint32_t capacity) {
+            if (!memory || slots < 2 || bytes < Bytes(slots, capacity) ||
+                reinterpret_cast<uintptr_t>(memory) % Detail::STATE_ALIGN != 0) {
+                GEKKO_MATH_ERROR("state export block too small or misaligned");
+                return;
+            }
+            _base = static_cast<unsigned char*>(memory);
+            _header = new (_base) Detail::StateHeader;
+            _header->version = Detail::STATE_VERSION;
+            _header->slots = slots;
+            _header->capacity = capacity;
+            _header->slot_bytes = Detail::SlotBytes(capacity);
+            _header->published.store(0, std::memory_order_relaxed);
+            for (uint32_t s = 0; s < slots; ++s) {
+                Detail::StateSlot* slot = new (Detail::SlotAt(_base, *_header, s)) Detail::StateSlot;
+                slot->sequence.store(0, std::memory_order_relaxed);
+                slot->count.store(0, std::memory_order_relaxed);
+                slot->id.store(0, std::memory_order_relaxed);
+            }
+            _header->magic.store(Detail::STATE_MAGIC, std::memory_order_release);
+        }
+
+        StateExport(const StateExport&) = delete;
+        StateExport& operator=(const StateExport&) = delete;
+
+        bool Valid() const {
+            return _header != nullptr;
+        }
+
+        uint32_t Capacity() const {
+            return _header ? _header->capacity : 0;
+        }
+
+        // positions as Vec3, count is clamped to the capacity
+        void Publish(const Vec3* positions, uint32_t count, uint64_t id) {
+            Write(count, id, [&](uint32_t n, int32_t* x, int32_t* y, int32_t* z, float* fx, float* fy, float* fz) {
+                for (uint32_t i = 0; i < n; ++i) {
+                    x[i] = positions[i].x.Raw();
+                    y[i] = positions[i].y.Raw();
+                    z[i] = positions[i].z.Raw();
+                }
+                AsFloatSoA(positions, n, fx, fy, fz);
+            });
+        }
+
+        // positions as separate Unit streams, count is clamped to the capacity
+        void Publish(const Unit* xs, const Unit* ys, const Unit* zs, uint32_t count, uint64_t id) {
+            Write(count, id, [&](uint32_t n, int32_t* x, int32_t* y, int32_t* z, float* fx, float* fy, float* fz) {
+                std::memcpy(x, xs, sizeof(int32_t) * n);
+                std::memcpy(y, ys, sizeof(int32_t) * n);
+                std::memcpy(z, zs, sizeof(int32_t) * n);
+                AsFloat(xs, n, fx);
+                AsFloat(ys, n, fy);
+                AsFloat(zs, n, fz);
+            });
+        }
+
+    private:
+        template <typename F>
+        void Write(uint32_t count, uint64_t id, F&& fill) {
+            if (!_header) {
+                return;
+            }
+            const uint32_t capacity = _header->capacity;
+            const uint32_t n = count < capacity ? count : capacity;
+            const uint64_t frame = _header->published.load(std::memory_order_relaxed);
+            Detail::StateSlot* slot = Detail::SlotAt(_base, *_header, frame);
+
+            const uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+            slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot->count.store(n, std::memory_order_relaxed);
+            slot->id.store(id, std::memory_order_relaxed);
+            fill(n,
+                reinterpret_cast<int32_t*>(Detail::StreamAt(slot, capacity, 0)),
+                reinterpret_cast<int32_t*>(Detail::StreamAt(slot, capacity, 1)),
+                reinterpret_cast<int32_t*>(Detail::StreamAt(slot, capacity, 2)),
+                reinterpret_cast<float*>(Detail::StreamAt(slot, capacity, 3)),
+                reinterpret_cast<float*>(Detail::StreamAt(slot, capacity, 4)),
+                reinterpret_cast<float*>(Detail::StreamAt(slot, capacity, 5)));
+
+            slot->sequence.store(sequence + 2, std::memory_order_release);
+            _header->published.store(frame + 1, std::memory_order_release);
+        }
+
+        unsigned char* _base = nullptr;
+        Detail::StateHeader* _header = nullptr;
+    };
+
+    // the reading side, in a tool process; never writes to the block
+    class StateView {
+    public:
+        // false from Valid() when the block has not been formatted (yet) or does not match
+        StateView(const void* memory, size_t bytes) {
+            Attach(memory, bytes);
+        }
+
+        // retries a failed attach, e.g. when the tool started before the simulation
+        bool Attach(const void* memory, size_t bytes) {
+            _header = nullptr;
+            if (!memory || bytes < sizeof(Detail::StateHeader)) {
+                return false;
+            }
+            unsigned char* base = static_cast<unsigned char*>(const_cast<void*>(memory));
+            Detail::StateHeader* h = reinterpret_cast<Detail::StateHeader*>(base);
+            if (h->magic.load(std::memory_order_acquire) != Detail::STATE_MAGIC || h->version != Detail::STATE_VERSION ||
+                h->slots < 2 || h->slot_bytes != Detail::SlotBytes(h->capacity) ||
+                bytes < StateExport::Bytes(h->slots, h->capacity)) {
+                return false;
+            }
+            _base = base;
+            _header = h;
+            return true;
+        }
+
+        bool Valid() const {
+            return _header != nullptr;
+        }
+
+        uint32_t Capacity() const {
+            return _header ? _header->capacity : 0;
+        }
+
+        // frames published so far
+        uint64_t Published() const {
+            return _header ? _header->published.load(std::memory_order_acquire) : 0;
+        }
+
+        // points 'frame' at the newest published slot; false before the first Publish. The data is
+        // only consistent if Validate(frame) still returns true after it was read.
+        bool Latest(StateFrame& frame) const {
+            const uint64_t published = Published();
+            if (published == 0) {
+                return false;
+            }
+            const uint64_t index = published - 1;
+            Detail::StateSlot* slot = Detail::SlotAt(_base, *_header, index);
+            const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                return false;
+            }
+            const uint32_t capacity = _header->capacity;
+            const uint32_t count = slot->count.load(std::memory_order_relaxed);
+            frame.id = slot->id.load(std::memory_order_relaxed);
+            frame.count = count < capacity ? count : capacity;
+            frame.x = reinterpret_cast<const int32_t*>(Detail::StreamAt(slot, capacity, 0));
+            frame.y = reinterpret_cast<const int32_t*>(Detail::StreamAt(slot, capacity, 1));
+            frame.z = reinterpret_cast<const int32_t*>(Detail::StreamAt(slot, capacity, 2));
+            frame.fx = reinterpret_cast<const float*>(Detail::StreamAt(slot, capacity, 3));
+            frame.fy = reinterpret_cast<const float*>(Detail::StreamAt(slot, capacity, 4));
+            frame.fz = reinterpret_cast<const float*>(Detail::StreamAt(slot, capacity, 5));
+            frame.slot = static_cast<uint32_t>(index % _header->slots);
+            frame.sequence = sequence;
+            return true;
+        }
+
+        // true when the slot 'frame' points at was not touched since Latest
+        bool Validate(const StateFrame& frame) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const Detail::StateSlot* slot = Detail::SlotAt(_base, *_header, frame.slot);
+            return slot->sequence.load(std::memory_order_relaxed) == frame.sequence;
+        }
+
+        // read(frame) on the newest frame until it validates; false when nothing was published or
+        // the writer lapped the reader 'attempts' times
+        template <typename F>
+        bool Read(F&& read, int attempts = 4) const {
+            for (int i = 0; i < attempts; ++i) {
+                StateFrame frame;
+                if (!Latest(frame)) {
+                    if (Published() == 0) {
+                        return false;
+                    }
+                    continue;
+                }
+                read(static_cast<const StateFrame&>(frame));
+                if (Validate(frame)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        unsigned char* _base = nullptr;
+        Detail::StateHeader* _header = nullptr;
+    };
+
+#if defined(GEKKO_STATE_EXPORT_POSIX)
+    // a named POSIX shared-memory mapping; the creator unlinks the name when it goes away
+    class SharedMemory {
+    public:
+        SharedMemory() = default;
+
+        // creates the object 'name' ("/name", under 256 characters) with 'bytes' bytes, mapped
+        // read-write; invalid when the name is taken, unless 'replace' unlinks the old object first
+        static SharedMemory Create(const char* name, size_t bytes, bool replace = false) {
+            SharedMemory m;
+            if (std::strlen(name) >= sizeof(m._name)) {
+                return m;
+            }
+            if (replace) {
+                shm_unlink(name);
+            }
+            int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                return m;
+            }
+            if (ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+                m.Map(fd, bytes, PROT_READ | PROT_WRITE);
+            }
+            close(fd);
+            if (m._data) {
+                std::strcpy(m._name, name);
+            }
+            else {
+                shm_unlink(name);
+            }
+            return m;
+        }
+
+        // maps an existing object read-only; invalid when it does not exist
+        static SharedMemory Open(const char* name) {
+            SharedMemory m;
+            int fd = shm_open(name, O_RDONLY, 0);
+            if (fd < 0) {
+                return m;
+            }
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                m.Map(fd, static_cast<size_t>(st.st_size), PROT_READ);
+            }
+            close(fd);
+            return m;
+        }
+
+        SharedMemory(SharedMemory&& other) noexcept {
+            *this = static_cast<SharedMemory&&>(other);
+        }
+
+        SharedMemory& operator=(SharedMemory&& other) noexcept {
+            if (this != &other) {
+                Release();
+                _data = other._data;
+                _size = other._size;
+                std::memcpy(_name, other._name, sizeof(_name));
+                other._data = nullptr;
+                other._size = 0;
+                other._name[0] = 0;
+            }
+            return *this;
+        }
+
+        ~SharedMemory() {
+            Release();
+        }
+
+        bool Valid() const {
+            return _data != nullptr;
+        }
+
+        void* Data() const {
+            return _data;
+        }
+
+        size_t Size() const {
+            return _size;
+        }
+
+    private:
+        void Map(int fd, size_t bytes, int protection) {
+            void* p = mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) {
+                _data = p;
+                _size = bytes;
+            }
+        }
+
+        void Release() {
+            if (_data) {
+                munmap(_data, _size);
+            }
+            if (_name[0]) {
+                shm_unlink(_name);
+            }
+            _data = nullptr;
+            _size = 0;
+            _name[0] = 0;
+        }
+
+        void* _data = nullptr;
+        size_t _size = 0;
+        char _name[256] = {};   // set for the creator only
+    };
+#endif
+}
@@ -0,0 +1,16 @@
+// C++20 module wrapper around the headers: `import gekko.math;`
+//
+// Errors follow GEKKO_MATH_TRAP_ON_ERROR, the same as the headers. The module owns its own copy of the
+// declarations, so a program should either import it or #include the headers, not both.
+module;
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+export module gekko.math;
+
+#define GEKKO_MATH_EXPORT export
+#include "gekko_math_exceptions.h"
+#include "gekko_math_debug.h"
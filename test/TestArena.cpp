@@ -0,0 +1,182 @@
+#include "gekko_math.h"
+#include "gekko_arena.h"
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestArena {
+    static bool Aligned(const void* p, size_t align) {
+        return reinterpret_cast<uintptr_t>(p) % align == 0;
+    }
+
+    void TestBump() {
+        FrameArena arena(1024);
+        assert(arena.Capacity() == 1024 && arena.Used() == 0);
+
+        void* a = arena.Allocate(3, 1);
+        void* b = arena.Allocate(8, 8);
+        void* c = arena.Allocate(16, 64);
+        assert(arena.Owns(a) && arena.Owns(b) && arena.Owns(c));
+        assert(Aligned(b, 8) && Aligned(c, 64));
+        assert(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+
+        Vec3* v = arena.AllocateArray<Vec3>(10);
+        assert(Aligned(v, alignof(Vec3)));
+        for (int i = 0; i < 10; ++i) {
+            v[i] = Vec3(Unit(i), Unit(i), Unit(i));
+        }
+        assert(v[9].x == 9);
+
+        arena.Reset();
+        assert(arena.Used() == 0);
+        assert(arena.HighWater() >= 64 + 16 + sizeof(Vec3) * 10);
+        assert(arena.Allocate(3, 1) == a);
+    }
+
+    void TestMarkRewind() {
+        FrameArena arena(256);
+        arena.Allocate(32);
+        FrameArena::Marker m = arena.Mark();
+        void* p = arena.Allocate(64);
+        arena.Rewind(m);
+        assert(arena.Used() == 32);
+        assert(arena.Allocate(64) == p);
+
+        {
+            ArenaScope scope(arena);
+            arena.Allocate(100);
+            assert(arena.Used() > 96);
+        }
+        assert(arena.Used() == 96);
+    }
+
+    void TestExhaustion() {
+        FrameArena arena(128);
+        assert(arena.TryAllocate(200) == nullptr);
+        assert(arena.Used() == 0);
+
+        bool thrown = false;
+        try {
+            arena.Allocate(129);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            arena.AllocateArray<Vec3>(SIZE_MAX / 2);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            arena.TryAllocate(8, 12);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && arena.Used() == 0);
+
+        // a count whose byte size wraps around must not come back as a small block
+        thrown = false;
+        try {
+            ArenaAllocator<Vec3>(arena).allocate(SIZE_MAX / sizeof(Vec3) + 2);
+        }
+        catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        assert(thrown && arena.Used() == 0);
+    }
+
+    void TestArenaArray() {
+        FrameArena arena(4096);
+        ArenaArray<Unit> units(arena, 4);
+        assert(units.Empty() && units.Capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            units.PushBack(Unit(i + 1));
+        }
+        Unit sum = 0;
+        for (const Unit& u : units) {
+            sum += u;
+        }
+        assert(sum == 10);
+
+        bool thrown = false;
+        try {
+            units.PushBack(Unit(5));
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && units.Size() == 4);
+
+        ArenaArray<Vec3> points(arena, 100);
+        points.Resize(100);
+        for (size_t i = 0; i < points.Size(); ++i) {
+            points[i] = Vec3(Unit(1), Unit(2), Unit(3)) * Unit(static_cast<int32_t>(i));
+        }
+        assert(points[99].z == 297);
+        points.Clear();
+        assert(points.Empty());
+    }
+
+    void TestAllocator() {
+        FrameArena arena(1 << 16);
+        std::vector<Vec3, ArenaAllocator<Vec3>> stream{ ArenaAllocator<Vec3>(arena) };
+        for (int i = 0; i < 500; ++i) {
+            stream.push_back(Vec3(Unit(i), Unit(0), Unit(0)));
+        }
+        assert(arena.Owns(stream.data()));
+        assert(stream[499].x == 499);
+
+        ArenaAllocator<uint32_t> rebound(stream.get_allocator());
+        assert(rebound.Arena() == &arena);
+        assert(rebound == stream.get_allocator());
+
+        FrameArena small(64);
+        std::vector<int, ArenaAllocator<int>> overflow{ ArenaAllocator<int>(small) };
+        bool thrown = false;
+        try {
+            overflow.resize(100);
+        }
+        catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    void TestThreadArena() {
+        FrameArena* main_arena = &ThreadArena();
+        assert(main_arena == &ThreadArena());
+        assert(main_arena->Capacity() == GEKKO_FRAME_ARENA_BYTES);
+        FrameArena* other = nullptr;
+        std::thread worker([&] {
+            other = &ThreadArena();
+        });
+        worker.join();
+        assert(other != main_arena);
+    }
+
+    TestArena() {
+        TestBump();
+        TestMarkRewind();
+        TestExhaustion();
+        TestArenaArray();
+        TestAllocator();
+        TestThreadArena();
+    }
+};
+
+static TestArena __test_arena;
+
+int main(void) {}
@@ -0,0 +1,193 @@
+#include "gekko_math.h"
+#include "gekko_containers.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace Gekko::Math;
+
+struct Proxy {
+    Vec3 min;
+    Vec3 max;
+    uint32_t body;
+};
+
+struct TestContainers {
+    using Manifold = SmallVec<Vec3, 4>;
+    using Proxies = Pool<Proxy, 64>;
+
+    static_assert(std::is_trivially_copyable<Manifold>::value, "SmallVec snapshots are memcpy");
+    static_assert(std::is_trivially_copyable<Proxies>::value, "Pool snapshots are memcpy");
+    static_assert(sizeof(Manifold) == sizeof(Vec3) * 4 + sizeof(uint32_t), "SmallVec storage is inline");
+
+    static Vec3 V(int32_t x, int32_t y, int32_t z) {
+        return Vec3(Unit(x), Unit(y), Unit(z));
+    }
+
+    void TestSmallVec() {
+        Manifold m;
+        assert(m.Empty() && Manifold::Capacity() == 4);
+        m.PushBack(V(1, 0, 0));
+        m.PushBack(V(2, 0, 0));
+        m.PushBack(V(3, 0, 0));
+        assert(m.Size() == 3 && m.Back() == V(3, 0, 0));
+
+        Unit sum = 0;
+        for (const Vec3& p : m) {
+            sum += p.x;
+        }
+        assert(sum == 6);
+
+        m.EraseSwap(0);
+        assert(m.Size() == 2 && m[0] == V(3, 0, 0) && m[1] == V(2, 0, 0));
+
+        m.PushBack(V(4, 0, 0));
+        m.PushBack(V(5, 0, 0));
+        assert(m.Full());
+        bool thrown = false;
+        try {
+            m.PushBack(V(6, 0, 0));
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && m.Size() == 4);
+
+        m.Resize(1);
+        assert(m.Size() == 1);
+        m.Resize(3);
+        assert(m[2] == V(0, 0, 0));
+        m.Clear();
+        assert(m.Empty());
+
+        // erasing past the end and Back on an empty vector report and leave it unchanged
+        int errors = 0;
+        try {
+            m.EraseSwap(0);
+        }
+        catch (const std::runtime_error&) {
+            errors++;
+        }
+        try {
+            m.Back();
+        }
+        catch (const std::runtime_error&) {
+            errors++;
+        }
+        m.PushBack(V(1, 0, 0));
+        try {
+            m.EraseSwap(1);
+        }
+        catch (const std::runtime_error&) {
+            errors++;
+        }
+        assert(errors == 3 && m.Size() == 1 && m[0] == V(1, 0, 0) && m[1] == V(0, 0, 0));
+    }
+
+    void TestSmallVecBytes() {
+        // the same contents reached by different histories are byte-identical
+        Manifold a;
+        Manifold b;
+        a.PushBack(V(1, 2, 3));
+        b.PushBack(V(1, 2, 3));
+        b.PushBack(V(7, 8, 9));
+        b.PushBack(V(4, 5, 6));
+        b.PopBack();
+        b.PopBack();
+        assert(a == b);
+        assert(std::memcmp(&a, &b, sizeof(Manifold)) == 0);
+
+        Manifold snapshot;
+        std::memcpy(&snapshot, &a, sizeof(Manifold));
+        a.PushBack(V(0, 0, 1));
+        a = snapshot;
+        assert(a.Size() == 1 && a == b);
+    }
+
+    void TestPool() {
+        Proxies pool;
+        assert(pool.Size() == 0 && Proxies::MaxSize() == 64);
+
+        Proxies::Handle h0 = pool.Create(Proxy{ V(0, 0, 0), V(1, 1, 1), 0 });
+        Proxies::Handle h1 = pool.Create(Proxy{ V(2, 0, 0), V(3, 1, 1), 1 });
+        Proxies::Handle h2 = pool.Create(Proxy{ V(4, 0, 0), V(5, 1, 1), 2 });
+        assert(h0.index == 0 && h1.index == 1 && h2.index == 2);
+        assert(pool.Size() == 3);
+        assert(pool.Get(h1)->body == 1);
+        assert(pool[2].min.x == 4);
+
+        // stable indices: destroying one object does not move the others
+        assert(pool.Destroy(h1));
+        assert(!pool.Destroy(h1));
+        assert(pool.Get(h1) == nullptr);
+        assert(pool.Get(h2)->body == 2 && pool.Size() == 2);
+
+        // the freed slot is reused with a new generation, the old handle stays stale
+        Proxies::Handle h3 = pool.Create(Proxy{ V(6, 0, 0), V(7, 1, 1), 3 });
+        assert(h3.index == h1.index && h3.generation != h1.generation);
+        assert(!pool.Valid(h1) && pool.Valid(h3));
+        assert(pool.HandleAt(1) == h3);
+        assert(!pool.Valid(Proxies::Handle{}));
+
+        uint32_t visited = 0;
+        uint32_t last = 0;
+        pool.ForEach([&](uint32_t index, Proxy& p) {
+            assert(visited == 0 || index > last);
+            last = index;
+            visited++;
+            p.body += 100;
+        });
+        assert(visited == 3 && pool.Get(h0)->body == 100);
+
+        Proxies full;
+        for (uint32_t i = 0; i < Proxies::MaxSize(); ++i) {
+            full.Create();
+        }
+        bool thrown = false;
+        try {
+            full.Create();
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && full.Size() == 64);
+    }
+
+    void TestPoolRollback() {
+        Proxies pool;
+        Proxies::Handle a = pool.Create(Proxy{ V(1, 1, 1), V(2, 2, 2), 7 });
+        pool.Create(Proxy{ V(3, 3, 3), V(4, 4, 4), 8 });
+        Proxies confirmed = pool;
+
+        // predicted frames create and destroy objects
+        pool.Destroy(a);
+        Proxies::Handle b = pool.Create(Proxy{ V(5, 5, 5), V(6, 6, 6), 9 });
+        pool.Create();
+
+        pool = confirmed;
+        assert(pool.Size() == 2);
+        assert(pool.Valid(a) && pool.Get(a)->body == 7);
+        assert(!pool.Valid(b));
+
+        // replaying the same operations from the same state gives the same bytes
+        Proxies replay = confirmed;
+        pool.Destroy(a);
+        replay.Destroy(a);
+        pool.Create(Proxy{ V(5, 5, 5), V(6, 6, 6), 9 });
+        replay.Create(Proxy{ V(5, 5, 5), V(6, 6, 6), 9 });
+        assert(std::memcmp(&pool, &replay, sizeof(Proxies)) == 0);
+    }
+
+    TestContainers() {
+        TestSmallVec();
+        TestSmallVecBytes();
+        TestPool();
+        TestPoolRollback();
+    }
+};
+
+static TestContainers __test_containers;
+
+int main(void) {}
@@ -0,0 +1,191 @@
+#include "gekko_math.h"
+#include "gekko_math_convert.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestConvert {
+    static const size_t MAX_COUNT = 37;
+
+    static int32_t NextRaw(uint32_t& state) {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int32_t>(state);
+    }
+
+    static std::vector<Vec3> Vectors(size_t count) {
+        uint32_t state = 12345;
+        std::vector<Vec3> v(count);
+        for (size_t i = 0; i < count; ++i) {
+            v[i] = Vec3(Unit::From(NextRaw(state)), Unit::From(NextRaw(state)), Unit::From(NextRaw(state)));
+        }
+        if (count > 2) {
+            v[1] = Vec3(Unit::From(-1), Unit::From(0x7FFFFFFF), Unit::From(-0x7FFFFFFF - 1));
+            v[2] = Vec3(Unit(0), Unit(1), Unit::From(Unit::HALF));
+        }
+        return v;
+    }
+
+    static bool Same(float a, float b) {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+
+    // every size around the 4- and 8-wide blocks, so both the vector body and the scalar tail run
+    void TestUnits() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> v = Vectors(n);
+            std::vector<Unit> units;
+            for (const Vec3& p : v) {
+                units.push_back(p.x);
+            }
+            std::vector<float> out(n + 1, 42.0f);
+            AsFloat(units.data(), n, out.data());
+            for (size_t i = 0; i < n; ++i) {
+                assert(Same(out[i], units[i].AsFloat()));
+            }
+            assert(out[n] == 42.0f);
+        }
+    }
+
+    void TestInterleaved() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> v = Vectors(n);
+            std::vector<float> xyz(3 * n + 1, 42.0f);
+            std::vector<Vec3F> vf(n);
+            AsFloatInterleaved(v.data(), n, xyz.data());
+            AsFloat(v.data(), n, vf.data());
+            for (size_t i = 0; i < n; ++i) {
+                Vec3F f = v[i].AsFloat();
+                assert(Same(xyz[3 * i + 0], f.x) && Same(xyz[3 * i + 1], f.y) && Same(xyz[3 * i + 2], f.z));
+                assert(Same(vf[i].x, f.x) && Same(vf[i].y, f.y) && Same(vf[i].z, f.z));
+            }
+            assert(xyz[3 * n] == 42.0f);
+        }
+    }
+
+    void TestPadded() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> v = Vectors(n);
+            std::vector<float> xyzw(4 * n + 1, 42.0f);
+            AsFloatPadded(v.data(), n, xyzw.data(), 1.0f);
+            for (size_t i = 0; i < n; ++i) {
+                Vec3F f = v[i].AsFloat();
+                assert(Same(xyzw[4 * i + 0], f.x) && Same(xyzw[4 * i + 1], f.y) && Same(xyzw[4 * i + 2], f.z));
+                assert(xyzw[4 * i + 3] == 1.0f);
+            }
+            assert(xyzw[4 * n] == 42.0f);
+        }
+
+        std::vector<Vec3> v = Vectors(5);
+        float xyzw[20];
+        AsFloatPadded(v.data(), 5, xyzw);
+        for (size_t i = 0; i < 5; ++i) {
+            assert(xyzw[4 * i + 3] == 0.0f);
+        }
+    }
+
+    void TestSoA() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> v = Vectors(n);
+            std::vector<float> x(n + 1, 42.0f), y(n + 1, 42.0f), z(n + 1, 42.0f);
+            AsFloatSoA(v.data(), n, x.data(), y.data(), z.data());
+            for (size_t i = 0; i < n; ++i) {
+                Vec3F f = v[i].AsFloat();
+                assert(Same(x[i], f.x) && Same(y[i], f.y) && Same(z[i], f.z));
+            }
+            assert(x[n] == 42.0f && y[n] == 42.0f && z[n] == 42.0f);
+        }
+    }
+
+    void TestStreamsToInterleaved() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> v = Vectors(n);
+            std::vector<Unit> xs, ys, zs;
+            for (const Vec3& p : v) {
+                xs.push_back(p.x);
+                ys.push_back(p.y);
+                zs.push_back(p.z);
+            }
+            std::vector<float> xyz(3 * n + 1, 42.0f);
+            AsFloatInterleaved(xs.data(), ys.data(), zs.data(), n, xyz.data());
+            for (size_t i = 0; i < n; ++i) {
+                Vec3F f = v[i].AsFloat();
+                assert(Same(xyz[3 * i + 0], f.x) && Same(xyz[3 * i + 1], f.y) && Same(xyz[3 * i + 2], f.z));
+            }
+            assert(xyz[3 * n] == 42.0f);
+        }
+    }
+
+    // buffers need no alignment beyond their element type
+    void TestUnaligned() {
+        const size_t n = 13;
+        std::vector<Vec3> v = Vectors(n + 1);
+        std::vector<float> xyzw(4 * n + 1);
+        AsFloatPadded(v.data() + 1, n, xyzw.data() + 1, 2.0f);
+        for (size_t i = 0; i < n; ++i) {
+            Vec3F f = v[i + 1].AsFloat();
+            assert(Same(xyzw[1 + 4 * i], f.x) && Same(xyzw[1 + 4 * i + 2], f.z));
+            assert(xyzw[1 + 4 * i + 3] == 2.0f);
+        }
+    }
+
+    void TestLerp() {
+        const float alphas[] = { 0.0f, 0.25f, 0.6f, 1.0f };
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Vec3> previous = Vectors(n);
+            std::vector<Vec3> current(n);
+            for (size_t i = 0; i < n; ++i) {
+                current[i] = previous[n - 1 - i];
+            }
+            for (float alpha : alphas) {
+                std::vector<float> xyz(3 * n + 1, 42.0f);
+                std::vector<float> xyzw(4 * n + 1, 42.0f);
+                std::vector<Vec3F> vf(n);
+                AsFloatLerpInterleaved(previous.data(), current.data(), n, alpha, xyz.data());
+                AsFloatLerpPadded(previous.data(), current.data(), n, alpha, xyzw.data(), 1.0f);
+                AsFloatLerp(previous.data(), current.data(), n, alpha, vf.data());
+                for (size_t i = 0; i < n; ++i) {
+                    const Vec3& p = previous[i];
+                    const Vec3& c = current[i];
+                    float x = AsFloatLerp(p.x, c.x, alpha), y = AsFloatLerp(p.y, c.y, alpha), z = AsFloatLerp(p.z, c.z, alpha);
+                    assert(Same(xyz[3 * i + 0], x) && Same(xyz[3 * i + 1], y) && Same(xyz[3 * i + 2], z));
+                    assert(Same(xyzw[4 * i + 0], x) && Same(xyzw[4 * i + 1], y) && Same(xyzw[4 * i + 2], z));
+                    assert(xyzw[4 * i + 3] == 1.0f);
+                    assert(Same(vf[i].x, x) && Same(vf[i].y, y) && Same(vf[i].z, z));
+                }
+                assert(xyz[3 * n] == 42.0f && xyzw[4 * n] == 42.0f);
+            }
+
+            // the endpoints are exactly the two frames
+            std::vector<Vec3F> at0(n), at1(n), p(n), c(n);
+            AsFloatLerp(previous.data(), current.data(), n, 0.0f, at0.data());
+            AsFloatLerp(previous.data(), current.data(), n, 1.0f, at1.data());
+            AsFloat(previous.data(), n, p.data());
+            AsFloat(current.data(), n, c.data());
+            assert(n == 0 || std::memcmp(at0.data(), p.data(), n * sizeof(Vec3F)) == 0);
+            assert(n == 0 || std::memcmp(at1.data(), c.data(), n * sizeof(Vec3F)) == 0);
+        }
+
+        Unit previous[5] = { Unit(0), Unit(2), Unit(-4), Unit(10), Unit(1) };
+        Unit current[5] = { Unit(1), Unit(4), Unit(4), Unit(-10), Unit(1) };
+        float out[5];
+        AsFloatLerp(previous, current, 5, 0.5f, out);
+        assert(out[0] == 0.5f && out[1] == 3.0f && out[2] == 0.0f && out[3] == 0.0f && out[4] == 1.0f);
+    }
+
+    TestConvert() {
+        TestUnits();
+        TestInterleaved();
+        TestPadded();
+        TestSoA();
+        TestStreamsToInterleaved();
+        TestUnaligned();
+        TestLerp();
+    }
+};
+
+static TestConvert __test_convert;
+
+int main(void) {}
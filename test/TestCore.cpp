@@ -0,0 +1,47 @@
+// Only the lightweight header (or the module when GEKKO_MATH_TEST_MODULE is defined),
+// no exceptions or iostream.
+#ifdef GEKKO_MATH_TEST_MODULE
+import gekko.math;
+#else
+#include "gekko_math_core.h"
+#endif
+
+#include <cassert>
+#include <cstdint>
+
+using namespace Gekko::Math;
+
+struct TestCore {
+    void TestUnit() {
+        Unit a = 3;
+        Unit b = 4;
+        assert(a + b == 7);
+        assert(b - a == 1);
+        assert(a * b == 12);
+        assert(Unit(12) / b == 3);
+        assert(Unit::SqrtNewton(16) == 4);
+        assert(Min(a, b) == a);
+        assert(Max(a, b) == b);
+        assert(Unit::From(Unit::HALF).Raw() == Unit::HALF);
+    }
+
+    void TestVec3() {
+        Vec3 v(Unit(3), Unit(4), Unit(0));
+        assert(v.Dot(v) == 25);
+
+        Vec3 w = v + Vec3(Unit(1), Unit(1), Unit(1));
+        assert(w.x == 4 && w.y == 5 && w.z == 1);
+
+        Vec3F f = w.AsFloat();
+        assert(f.x == 4.0f && f.y == 5.0f && f.z == 1.0f);
+    }
+
+    TestCore() {
+        TestUnit();
+        TestVec3();
+    }
+};
+
+static TestCore __test_core;
+
+int main(void) {}
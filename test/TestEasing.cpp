@@ -0,0 +1,150 @@
+#include "gekko_math.h"
+#include "gekko_easing.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestEasing {
+    static const int CURVES = static_cast<int>(Easing::BounceInOut) + 1;
+
+    // the In curve of each family in double, in enum order
+    static double In(int family, double t) {
+        const double pi = 3.14159265358979323846, c1 = 1.70158, n1 = 7.5625, d1 = 2.75;
+        switch (family) {
+        case 0: return t * t;
+        case 1: return t * t * t;
+        case 2: return t * t * t * t;
+        case 3: return t * t * t * t * t;
+        case 4: return 1 - std::cos(t * pi / 2);
+        case 5: return t == 0 ? 0 : std::pow(2, 10 * t - 10);
+        case 6: return 1 - std::sqrt(1 - t * t);
+        case 7: return (c1 + 1) * t * t * t - c1 * t * t;
+        case 8: return t == 0 || t == 1 ? t : -std::pow(2, 10 * t - 10) * std::sin((t * 10 - 10.75) * 2 * pi / 3);
+        default: {
+            double x = 1 - t, out;
+            if (x < 1 / d1) {
+                out = n1 * x * x;
+            }
+            else if (x < 2 / d1) {
+                x -= 1.5 / d1;
+                out = n1 * x * x + 0.75;
+            }
+            else if (x < 2.5 / d1) {
+                x -= 2.25 / d1;
+                out = n1 * x * x + 0.9375;
+            }
+            else {
+                x -= 2.625 / d1;
+                out = n1 * x * x + 0.984375;
+            }
+            return 1 - out;
+        }
+        }
+    }
+
+    static double Reference(Easing easing, double t) {
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+        if (easing == Easing::Linear) {
+            return t;
+        }
+        const int family = (static_cast<int>(easing) - 1) / 3, mode = (static_cast<int>(easing) - 1) % 3;
+        if (mode == 0) {
+            return In(family, t);
+        }
+        if (mode == 1) {
+            return 1 - In(family, 1 - t);
+        }
+        return t < 0.5 ? In(family, 2 * t) / 2 : 1 - In(family, 2 - 2 * t) / 2;
+    }
+
+    // every curve within 2 LSB of the double formula over all of [0, 1]
+    void TestCurves() {
+        for (int e = 0; e < CURVES; ++e) {
+            const Easing easing = static_cast<Easing>(e);
+            for (int32_t raw = 0; raw <= Unit::ONE; ++raw) {
+                const double expected = Reference(easing, static_cast<double>(raw) / Unit::ONE) * Unit::ONE;
+                assert(std::abs(Ease(easing, Unit::From(raw)).Raw() - expected) <= 2.0);
+            }
+        }
+    }
+
+    // exact ends and midpoints, clamping, and the overshooting families
+    void TestShape() {
+        for (int e = 0; e < CURVES; ++e) {
+            const Easing easing = static_cast<Easing>(e);
+            assert(Ease(easing, Unit(0)) == Unit(0) && Ease(easing, Unit(1)) == Unit(1));
+            assert(Ease(easing, Unit(-3)) == Unit(0) && Ease(easing, Unit::From(INT32_MAX)) == Unit(1));
+            if (e != 0 && (e - 1) % 3 == 2) {
+                assert(Ease(easing, Unit::From(Unit::HALF)) == Unit::From(Unit::HALF));
+            }
+        }
+
+        // the polynomial families are monotonic; back dips below 0 and elastic overshoots 1
+        for (Easing easing : { Easing::QuadIn, Easing::CubicOut, Easing::QuartInOut, Easing::QuintIn, Easing::SineInOut, Easing::CircOut }) {
+            for (int32_t raw = 1; raw <= Unit::ONE; ++raw) {
+                assert(Ease(easing, Unit::From(raw)) >= Ease(easing, Unit::From(raw - 1)));
+            }
+        }
+        bool dips = false, overshoots = false;
+        for (int32_t raw = 0; raw <= Unit::ONE; raw += 64) {
+            dips = dips || Ease(Easing::BackIn, Unit::From(raw)) < Unit(0);
+            overshoots = overshoots || Ease(Easing::ElasticOut, Unit::From(raw)) > Unit(1);
+        }
+        assert(dips && overshoots);
+    }
+
+    // the batch matches the scalar form for every curve, in place as well
+    void TestBatch() {
+        std::vector<Unit> t, out(203), inPlace;
+        for (int32_t i = 0; i < 203; ++i) {
+            t.push_back(Unit::From(i * 331 - 2 * Unit::ONE));
+        }
+        for (int e = 0; e < CURVES; ++e) {
+            const Easing easing = static_cast<Easing>(e);
+            inPlace = t;
+            Ease(easing, t.data(), t.size(), out.data());
+            Ease(easing, inPlace.data(), inPlace.size(), inPlace.data());
+            for (size_t i = 0; i < t.size(); ++i) {
+                assert(out[i] == Ease(easing, t[i]) && inPlace[i] == out[i]);
+            }
+        }
+    }
+
+    void TestTween() {
+        // holds the ends, and spans wider than the Unit range interpolate in 64 bits
+        Tween dash(Unit(2), Unit(14), Unit(20), Easing::QuadOut);
+        assert(dash.Sample(Unit(-1)) == Unit(2) && dash.Sample(Unit(0)) == Unit(2));
+        assert(dash.Sample(Unit(20)) == Unit(14) && dash.Sample(Unit(90)) == Unit(14));
+        assert(dash.Sample(Unit(10)) == Unit(11));
+        Tween wide(Unit(-60000), Unit(60000), Unit(4), Easing::Linear);
+        assert(wide.Sample(Unit(2)) == Unit(0) && wide.Sample(Unit(1)) == Unit(-30000));
+
+        // knockback falloff: the batch matches single samples, in place as well
+        Tween falloff(Unit(8), Unit(0), Unit(7), Easing::ExpoOut);
+        std::vector<Unit> elapsed, out(50);
+        for (int32_t i = 0; i < 50; ++i) {
+            elapsed.push_back(Unit::From(i * Unit::ONE / 6 - Unit::ONE));
+        }
+        falloff.Sample(elapsed.data(), elapsed.size(), out.data());
+        for (size_t i = 0; i < elapsed.size(); ++i) {
+            assert(out[i] == falloff.Sample(elapsed[i]));
+        }
+        falloff.Sample(elapsed.data(), elapsed.size(), elapsed.data());
+        assert(elapsed == out);
+    }
+
+    TestEasing() {
+        TestCurves();
+        TestShape();
+        TestBatch();
+        TestTween();
+    }
+};
+
+static TestEasing __test_easing;
+
+int main(void) {}
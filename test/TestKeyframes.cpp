@@ -0,0 +1,176 @@
+#include "gekko_math.h"
+#include "gekko_keyframes.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestKeyframes {
+    static const Interpolation MODES[3];
+
+    // 'count' keys a third to one and a third units apart, with slopes and controls
+    static std::vector<Keyframe> Keys(uint32_t seed, uint32_t count) {
+        std::vector<Keyframe> keys(count);
+        uint32_t h = seed;
+        auto next = [&h](int32_t range) {
+            h = h * 1664525u + 1013904223u;
+            return static_cast<int32_t>(h >> 8) % range;
+        };
+        int32_t t = next(Unit::ONE);
+        for (Keyframe& k : keys) {
+            k.time = Unit::From(t);
+            k.value = Unit::From(next(8 * Unit::ONE));
+            k.in = Unit::From(next(4 * Unit::ONE));
+            k.out = Unit::From(next(4 * Unit::ONE));
+            t += Unit::ONE / 3 + std::abs(next(Unit::ONE));
+        }
+        return keys;
+    }
+
+    static bool Near(Unit a, Unit b, int32_t lsb) {
+        return std::abs(a.Raw() - b.Raw()) <= lsb;
+    }
+
+    // keys are hit exactly and sampling clamps to the ends
+    void TestEndpoints() {
+        std::vector<Keyframe> keys = Keys(1, 9);
+        for (Interpolation mode : MODES) {
+            KeyTrack track(keys.data(), 9, mode);
+            for (const Keyframe& k : keys) {
+                assert(track.Sample(k.time) == k.value);
+            }
+            assert(track.Sample(keys[0].time - Unit(5)) == keys[0].value);
+            assert(track.Sample(keys[8].time + Unit(5)) == keys[8].value);
+            assert(track.Sample(Unit::From(INT32_MIN)) == keys[0].value);
+        }
+
+        // no keys, one key
+        assert(KeyTrack().Sample(Unit(3)) == Unit(0));
+        const Keyframe one[] = { { Unit(2), Unit(7) } };
+        assert(KeyTrack(one, 1, Interpolation::Bezier).Sample(Unit(-1)) == Unit(7));
+    }
+
+    void TestShapes() {
+        // linear: halfway is the mean
+        const Keyframe line[] = { { Unit(0), Unit(0) }, { Unit(2), Unit(10) }, { Unit(4), Unit(-10) } };
+        KeyTrack linear(line, 3, Interpolation::Linear);
+        assert(linear.Sample(Unit(1)) == Unit(5));
+        assert(linear.Sample(Unit(3)) == Unit(0));
+
+        // a straight line in Hermite (slope 5) and Bezier (controls at thirds) form stays on the line,
+        // up to the Q15 resolution of the segment parameter times the 10 units the segment spans
+        const Keyframe hermite[] = { { Unit(0), Unit(0), Unit(5), Unit(5) }, { Unit(2), Unit(10), Unit(5), Unit(5) } };
+        const Unit third = Unit(10) / Unit(3);
+        const Keyframe bezier[] = { { Unit(0), Unit(0), Unit(0), third }, { Unit(2), Unit(10), Unit(10) - third, Unit(0) } };
+        KeyTrack h(hermite, 2, Interpolation::Hermite), b(bezier, 2, Interpolation::Bezier);
+        for (int32_t raw = 0; raw <= 2 * Unit::ONE; raw += 97) {
+            Unit t = Unit::From(raw);
+            assert(Near(h.Sample(t), t * Unit(5), 16));
+            assert(Near(b.Sample(t), t * Unit(5), 16));
+        }
+
+        // flat keys stay exactly flat, the weights add up to one
+        const Keyframe level[] = { { Unit(0), Unit(3) }, { Unit(1), Unit(3) } };
+        const Keyframe controls[] = { { Unit(0), Unit(3), Unit(3), Unit(3) }, { Unit(1), Unit(3), Unit(3), Unit(3) } };
+        for (Interpolation mode : MODES) {
+            KeyTrack f(mode == Interpolation::Bezier ? controls : level, 2, mode);
+            for (int32_t raw = 0; raw <= Unit::ONE; raw += 13) {
+                assert(f.Sample(Unit::From(raw)) == Unit(3));
+            }
+        }
+
+        // midpoint of a steep start: 8/8 + 1/2 as Hermite, 3/8 * 8 + 1/8 as Bezier
+        const Keyframe steep[] = { { Unit(0), Unit(0), Unit(0), Unit(8) }, { Unit(1), Unit(1) } };
+        const Unit half = Unit::From(Unit::HALF);
+        assert(KeyTrack(steep, 2, Interpolation::Hermite).Sample(half) == Unit(3) / Unit(2));
+        assert(KeyTrack(steep, 2, Interpolation::Bezier).Sample(half) == Unit(25) / Unit(8));
+    }
+
+    // the cursor is only a hint: forward, backward and jumping samples match the plain search
+    void TestCursor() {
+        std::vector<Keyframe> keys = Keys(2, 40);
+        for (Interpolation mode : MODES) {
+            KeyTrack track(keys.data(), 40, mode);
+            TrackCursor cursor;
+            const Unit start = keys[0].time - Unit(1), end = keys[39].time + Unit(1);
+            for (Unit t = start; t < end; t += Unit::From(Unit::ONE / 16)) {
+                assert(track.Sample(t, cursor) == track.Sample(t));
+            }
+            assert(cursor.segment == 38);
+            for (Unit t = end; t > start; t -= Unit::From(Unit::ONE / 7)) {
+                assert(track.Sample(t, cursor) == track.Sample(t));
+            }
+            assert(cursor.segment == 0);
+            uint32_t h = 5;
+            for (int i = 0; i < 500; ++i) {
+                h = h * 1664525u + 1013904223u;
+                Unit t = start + Unit::From(static_cast<int32_t>(h % static_cast<uint32_t>((end - start).Raw())));
+                assert(track.Sample(t, cursor) == track.Sample(t));
+            }
+
+            // a cursor left on another, longer track
+            TrackCursor stale{ 1000 };
+            assert(track.Sample(keys[3].time, stale) == keys[3].value && stale.segment == 3);
+        }
+    }
+
+    // clip channels and track batches agree with single tracks
+    void TestClip() {
+        const uint32_t count = 12, channels = 7;
+        std::vector<Keyframe> keys[channels];
+        for (uint32_t c = 0; c < channels; ++c) {
+            keys[c] = Keys(3, count);
+            std::vector<Keyframe> other = Keys(100 + c, count);
+            for (uint32_t k = 0; k < count; ++k) {
+                keys[c][k].value = other[k].value;
+                keys[c][k].in = other[k].in;
+                keys[c][k].out = other[k].out;
+            }
+        }
+        std::vector<Unit> times, values, ins, outs;
+        for (uint32_t k = 0; k < count; ++k) {
+            times.push_back(keys[0][k].time);
+            for (uint32_t c = 0; c < channels; ++c) {
+                values.push_back(keys[c][k].value);
+                ins.push_back(keys[c][k].in);
+                outs.push_back(keys[c][k].out);
+            }
+        }
+
+        for (Interpolation mode : MODES) {
+            KeyClip clip(times.data(), count, channels, mode, values.data(),
+                mode == Interpolation::Linear ? nullptr : ins.data(), mode == Interpolation::Linear ? nullptr : outs.data());
+            KeyTrack tracks[channels];
+            for (uint32_t c = 0; c < channels; ++c) {
+                tracks[c] = KeyTrack(keys[c].data(), count, mode);
+            }
+            TrackCursor clipCursor, cursors[channels];
+            Unit fromClip[channels + 1], fromTracks[channels];
+            fromClip[channels] = Unit(42);
+            for (Unit t = times[0] - Unit(1); t < times[count - 1] + Unit(1); t += Unit::From(Unit::ONE / 10)) {
+                clip.Sample(t, clipCursor, fromClip);
+                Sample(tracks, channels, t, cursors, fromTracks);
+                for (uint32_t c = 0; c < channels; ++c) {
+                    assert(fromClip[c] == fromTracks[c] && fromTracks[c] == tracks[c].Sample(t));
+                    assert(clip.Sample(t, c) == fromClip[c]);
+                }
+                assert(fromClip[channels] == Unit(42));
+            }
+        }
+    }
+
+    TestKeyframes() {
+        TestEndpoints();
+        TestShapes();
+        TestCursor();
+        TestClip();
+    }
+};
+
+const Interpolation TestKeyframes::MODES[3] = { Interpolation::Linear, Interpolation::Hermite, Interpolation::Bezier };
+
+static TestKeyframes __test_keyframes;
+
+int main(void) {}
@@ -7,6 +7,11 @@
 
 using namespace Gekko::Math;
 
+// gekko_math.h declares no stream operators, so an includer's own stays unambiguous
+static std::ostream& operator<<(std::ostream& os, const Unit& u) {
+    return os << u.AsFloat();
+}
+
 struct TestMath {
     // Helper for comparing floats within a tolerance.
     bool AlmostEqual(float a, float b, float epsilon = 1e-4f) {
@@ -61,6 +66,7 @@ struct TestMath {
                 Unit a = 5;
                 Unit b(0);
                 Unit c = a / b;
+                (void)c;
             }
             catch (const std::runtime_error&) {
                 exceptionThrown = true;
@@ -124,6 +130,15 @@ struct TestMath {
             assert(AlmostEqual(Unit::SqrtNewton(0).AsFloat(), 0.0f));
             assert(AlmostEqual(Unit::SqrtNewton(1).AsFloat(), 1.0f));
 
+            // Fractions below one
+            std::cout << "sqrt(0.25): " << Unit::SqrtNewton(Unit::From(Unit::ONE / 4)).AsFloat() << "\n";
+            assert(AlmostEqual(Unit::SqrtNewton(Unit::From(Unit::ONE / 4)).AsFloat(), 0.5f));
+            assert(AlmostEqual(Unit::SqrtNewton(Unit::From(Unit::HALF)).AsFloat(), std::sqrt(0.5f)));
+
+            // The top of the range, where x + u / x no longer fits in int32
+            assert(std::fabs(Unit::SqrtNewton(Unit::From(INT32_MAX)).AsFloat() - 256.0f) < 0.5f);
+            assert(std::fabs(Unit::SqrtNewton(Unit::From(INT32_MAX - Unit::ONE / 2)).AsFloat() - 256.0f) < 0.5f);
+
             // Negative input should throw an exception
             bool exceptionThrown = false;
             try {
@@ -213,6 +228,7 @@ struct TestMath {
     TestMath() {
         TestUnitArithmetic();
         TestVec3Arithmetic();
+        std::cout << "half: " << Unit::From(Unit::HALF) << "\n";
         std::cout << "All math tests passed.\n";
     }
 };
@@ -0,0 +1,273 @@
+#include "alloc_guard.h"
+#include "gekko_math.h"
+#include "gekko_math_stats.h"
+#include "gekko_arena.h"
+#include "gekko_parallel.h"
+#include "gekko_render_channel.h"
+#include "gekko_state_export.h"
+#include "gekko_profile.h"
+#include "gekko_random.h"
+#include "gekko_noise.h"
+#include "gekko_keyframes.h"
+#include "gekko_spline.h"
+#include "gekko_easing.h"
+#include "scenarios.h"
+
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#if !defined(GEKKO_MATH_COUNT_OPS) || !defined(GEKKO_MATH_PROFILE)
+#error "TestNoAlloc needs GEKKO_MATH_COUNT_OPS and GEKKO_MATH_PROFILE so the instrumented paths are covered"
+#endif
+
+using namespace Gekko::Math;
+using Gekko::Test::NoAllocScope;
+
+// Hot-path APIs must not touch the heap once warmed up: each check runs its body once to warm
+// up (thread-local tables, profiler rings) and then again with allocations counted.
+struct TestNoAlloc {
+    int failures = 0;
+
+    template <typename F>
+    void Check(const char* name, F&& body) {
+        body();
+        uint64_t count;
+        {
+            NoAllocScope scope;
+            body();
+            count = scope.Count();
+        }
+        if (count != 0) {
+            std::printf("%s allocated %llu times after warmup\n", name, static_cast<unsigned long long>(count));
+            failures++;
+        }
+    }
+
+    void TestHarness() {
+        NoAllocScope scope;
+        std::vector<int> v;
+        v.push_back(1);
+        assert(scope.Count() > 0);
+#if defined(GEKKO_TEST_HOOK_MALLOC)
+        uint64_t before = scope.Count();
+        void* p = std::malloc(16);
+        std::free(p);
+        assert(scope.Count() == before + 1);
+#endif
+    }
+
+    void TestUnit() {
+        Check("unit.arithmetic", [] {
+            volatile int32_t seed = 12345;
+            Unit a = Unit::From(seed);
+            Unit b = Unit::From(seed / 3 + 1);
+            Unit c = (a + b) * (a - b) / b;
+            c += a;
+            c -= b;
+            c *= b;
+            c /= a;
+            c = Unit::SqrtNewton(Max(c, -c));
+            volatile float f = Min(a, c).AsFloat();
+            (void)f;
+        });
+    }
+
+    void TestVec3() {
+        std::vector<Vec3> in(256);
+        std::vector<Vec3F> out(256, Vec3F(0, 0, 0));
+        for (size_t i = 0; i < in.size(); ++i) {
+            in[i] = Vec3(Unit(static_cast<int32_t>(i % 7) + 1), Unit(2), Unit::From(static_cast<int32_t>(i) * 97 + 1));
+        }
+        Check("vec3.batch", [&] {
+            Vec3 acc(Unit(0), Unit(0), Unit(0));
+            for (size_t i = 0; i < in.size(); ++i) {
+                const Vec3& v = in[i];
+                acc += (v * Unit(2) - v / Unit(3)) + Unit(1);
+                acc.x = Unit::From(acc.x.Raw() & 0xFFFFF);
+                out[i] = (v * v.Dot(v) / v).AsFloat();
+            }
+            assert(acc.x.Raw() >= 0);
+        });
+    }
+
+    void TestInstrumentation() {
+        Check("stats.scope", [] {
+            Stats::Scope scope("tick");
+            Unit x = Unit::SqrtNewton(Unit(9)) * Unit(2);
+            (void)x;
+            Stats::Snapshot s = Stats::SnapshotAndReset();
+            (void)s;
+        });
+
+        Gekko::Profile::Profiler::Get().Start();
+        Check("profile.zone", [] {
+            for (int i = 0; i < 64; ++i) {
+                GEKKO_PROFILE_ZONE("zone");
+            }
+        });
+        Gekko::Profile::Profiler::Get().Stop();
+    }
+
+    void TestArena() {
+        FrameArena& arena = ThreadArena();
+        Check("arena.frame", [&] {
+            arena.Reset();
+            ArenaArray<Vec3> stream(arena, 512);
+            for (int i = 0; i < 512; ++i) {
+                stream.PushBack(Vec3(Unit(i), Unit(1), Unit(2)));
+            }
+            ArenaScope scope(arena);
+            std::vector<uint32_t, ArenaAllocator<uint32_t>> pairs{ ArenaAllocator<uint32_t>(arena) };
+            pairs.reserve(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                pairs.push_back(i);
+            }
+        });
+    }
+
+    void TestParallel() {
+        ThreadPool pool(2);
+        std::vector<Vec3> pos(4096, Vec3(Unit(1), Unit(2), Unit(3)));
+        Check("parallel.for_reduce", [&] {
+            ParallelFor(pool, pos.size(), 256, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    pos[i] += Vec3(Unit(0), Unit(0), Unit(0));
+                }
+            });
+            Unit sum = ParallelReduce(pool, pos.size(), 256, Unit(0), [&](size_t begin, size_t end) {
+                Unit s = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    s += pos[i].x;
+                }
+                return s;
+            }, [](Unit a, Unit b) { return a + b; });
+            assert(sum == 4096);
+        });
+    }
+
+    void TestRenderChannel() {
+        RenderChannel channel(1024);
+        std::vector<Vec3> pos(1024, Vec3(Unit(1), Unit(2), Unit(3)));
+        uint64_t id = 0;
+        Check("render_channel.publish_acquire", [&] {
+            channel.Publish(pos.data(), pos.size(), ++id);
+            const RenderChannel::Frame* f = channel.Acquire();
+            assert(f && f->id == id);
+        });
+    }
+
+    void TestStateExport() {
+        std::vector<uint64_t> block(StateExport::Bytes(4, 1024) / sizeof(uint64_t) + 8);
+        void* aligned = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(block.data()) + 63) & ~uintptr_t(63));
+        StateExport out(aligned, StateExport::Bytes(4, 1024), 4, 1024);
+        StateView in(aligned, StateExport::Bytes(4, 1024));
+        std::vector<Vec3> pos(1024, Vec3(Unit(1), Unit(2), Unit(3)));
+        uint64_t id = 0;
+        Check("state_export.publish_read", [&] {
+            out.Publish(pos.data(), 1024, ++id);
+            assert(in.Read([&](const StateFrame& f) { assert(f.id == id); }));
+        });
+    }
+
+    void TestRandom() {
+        Random rng(1);
+        RandomBatch batch(1);
+        std::vector<Unit> out(1000);
+        Check("random.scalar_batch", [&] {
+            Vec3 d = rng.Direction() + rng.InSphere(Unit(2));
+            out[0] = rng.Gaussian() + d.x;
+            batch.FillRange(out.data(), out.size(), Unit(-1), Unit(1));
+        });
+    }
+
+    void TestNoise() {
+        std::vector<Unit> xs(1000, Unit::From(12345)), ys(1000, Unit::From(-6789)), out(1000);
+        Check("noise.scalar_batch", [&] {
+            out[0] = Perlin(Vec3(xs[0], ys[0], Unit(3))) + Simplex(xs[0], ys[0]);
+            Simplex(xs.data(), ys.data(), xs.data(), out.size(), out.data());
+        });
+    }
+
+    void TestKeyframes() {
+        const Keyframe keys[] = { { Unit(0), Unit(1), Unit(0), Unit(2) }, { Unit(1), Unit(3), Unit(1), Unit(0) }, { Unit(2), Unit(0) } };
+        const Unit times[] = { Unit(0), Unit(1), Unit(2) }, values[] = { Unit(1), Unit(2), Unit(3), Unit(4), Unit(5), Unit(6) };
+        KeyTrack track(keys, 3, Interpolation::Hermite);
+        KeyClip clip(times, 3, 2, Interpolation::Linear, values);
+        TrackCursor cursor, clipCursor;
+        Unit out[2];
+        Check("keyframes.track_clip", [&] {
+            out[0] = track.Sample(Unit::From(Unit::ONE + Unit::HALF), cursor) + track.Sample(Unit::From(Unit::HALF));
+            clip.Sample(Unit::From(Unit::HALF), clipCursor, out);
+        });
+    }
+
+    void TestSpline() {
+        const Vec3 points[] = { Vec3(Unit(0), Unit(0), Unit(0)), Vec3(Unit(1), Unit(2), Unit(0)), Vec3(Unit(3), Unit(2), Unit(1)),
+            Vec3(Unit(4), Unit(0), Unit(1)) };
+        Spline spline(points, 4, SplineKind::CatmullRom);
+        Unit lengths[3 * 8 + 1];
+        Vec3 out[3 * 8 + 1];
+        TrackCursor cursor;
+        Check("spline.tessellate_arc", [&] {
+            spline.Tessellate(8, out);
+            ArcLengthTable table(spline, 8, lengths);
+            out[0] = table.Evaluate(Unit(2), cursor) + spline.Tangent(Unit(1));
+            out[1] = spline.Evaluate(spline.Closest(Vec3(Unit(2), Unit(3), Unit(0))));
+        });
+    }
+
+    void TestEasing() {
+        const Unit t[] = { Unit(0), Unit::From(Unit::HALF), Unit(1) };
+        Unit out[3];
+        Tween dash(Unit(0), Unit(12), Unit(20), Easing::QuadOut);
+        Check("easing.scalar_batch", [&] {
+            out[0] = Ease(Easing::ElasticInOut, Unit::From(Unit::HALF / 3)) + dash.Sample(Unit(5));
+            Ease(Easing::BounceOut, t, 3, out);
+            dash.Sample(t, 3, out);
+        });
+    }
+
+    template <typename Scene>
+    void CheckScene(const char* name, Scene& scene) {
+        Check(name, [&] {
+            for (int frame = 0; frame < 3; ++frame) {
+                scene.Step();
+            }
+        });
+    }
+
+    void TestScenarios() {
+        using namespace Gekko::Bench;
+        ParticleSwarm<Unit> particles(500);
+        NBody<Unit> nbody(64);
+        CollisionScene<Unit> collision(500, 12);
+        Rollback<Unit> rollback(200, 10, 4);
+        CheckScene("scenario.particles", particles);
+        CheckScene("scenario.nbody", nbody);
+        CheckScene("scenario.collision", collision);
+        CheckScene("scenario.rollback", rollback);
+    }
+
+    TestNoAlloc() {
+        TestHarness();
+        TestUnit();
+        TestVec3();
+        TestInstrumentation();
+        TestArena();
+        TestParallel();
+        TestRenderChannel();
+        TestStateExport();
+        TestRandom();
+        TestNoise();
+        TestKeyframes();
+        TestSpline();
+        TestEasing();
+        TestScenarios();
+        assert(failures == 0);
+    }
+};
+
+static TestNoAlloc __test_no_alloc;
+
+int main(void) {}
@@ -0,0 +1,98 @@
+#include "gekko_math.h"
+#include "gekko_noise.h"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestNoise {
+    static const size_t MAX_COUNT = 37;
+
+    // spread over a few hundred cells, both signs, off-lattice
+    static std::vector<Unit> Coordinates(uint32_t seed, size_t count) {
+        std::vector<Unit> out(count);
+        uint32_t h = seed;
+        for (size_t i = 0; i < count; ++i) {
+            h = h * 1664525u + 1013904223u;
+            out[i] = Unit::From(static_cast<int32_t>(h >> 8) - (1 << 23));
+        }
+        return out;
+    }
+
+    void TestLattice() {
+        for (int x = -5; x <= 5; ++x) {
+            for (int y = -5; y <= 5; ++y) {
+                assert(Perlin(Unit(x), Unit(y), 3) == Unit(0));
+                assert(Perlin(Vec3(Unit(x), Unit(y), Unit(x - y)), 3) == Unit(0));
+            }
+        }
+
+        // the seed picks a different field
+        Unit x = Unit::From(12345), y = Unit::From(-98765);
+        assert(Perlin(x, y, 1) != Perlin(x, y, 2));
+        assert(Simplex(x, y, 1) != Simplex(x, y, 2));
+        assert(Perlin(x, y, 1) == Perlin(x, y, 1));
+    }
+
+    // bounded, centered, and no jumps between neighbouring points
+    void TestShape() {
+        const size_t n = 20000;
+        std::vector<Unit> xs = Coordinates(1, n), ys = Coordinates(2, n), zs = Coordinates(3, n);
+        const Unit step = Unit::From(8);
+        double sum[4] = {};
+        for (size_t i = 0; i < n; ++i) {
+            Vec3 p(xs[i], ys[i], zs[i]);
+            Unit v[4] = { Perlin(xs[i], ys[i]), Perlin(p), Simplex(xs[i], ys[i]), Simplex(p) };
+            Unit w[4] = { Perlin(xs[i] + step, ys[i]), Perlin(Vec3(p.x, p.y, p.z + step)),
+                Simplex(xs[i], ys[i] + step), Simplex(Vec3(p.x + step, p.y, p.z)) };
+            for (int k = 0; k < 4; ++k) {
+                assert(v[k] > Unit::From(-Unit::ONE - 256) && v[k] < Unit::From(Unit::ONE + 256));
+                assert(std::abs(v[k].Raw() - w[k].Raw()) < 256);
+                sum[k] += v[k].AsFloat();
+            }
+        }
+        for (double s : sum) {
+            assert(std::fabs(s / n) < 0.03);
+        }
+
+        // the extremes of the coordinate range do not overflow
+        const Unit lo = Unit::From(INT32_MIN), hi = Unit::From(INT32_MAX);
+        for (Unit v : { Perlin(lo, hi), Perlin(Vec3(hi, lo, hi)), Simplex(hi, lo), Simplex(Vec3(lo, lo, lo)), Simplex(Vec3(hi, hi, hi)) }) {
+            assert(v > Unit(-2) && v < Unit(2));
+        }
+    }
+
+    // the SoA samplers match the scalar functions for every count and leave the rest alone
+    void TestBatch() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            std::vector<Unit> xs = Coordinates(10 + static_cast<uint32_t>(n), n);
+            std::vector<Unit> ys = Coordinates(20 + static_cast<uint32_t>(n), n);
+            std::vector<Unit> zs = Coordinates(30 + static_cast<uint32_t>(n), n);
+            std::vector<Unit> p2(n + 1, Unit(42)), p3(n + 1, Unit(42)), s2(n + 1, Unit(42)), s3(n + 1, Unit(42));
+            Perlin(xs.data(), ys.data(), n, p2.data(), 77);
+            Perlin(xs.data(), ys.data(), zs.data(), n, p3.data(), 77);
+            Simplex(xs.data(), ys.data(), n, s2.data(), 77);
+            Simplex(xs.data(), ys.data(), zs.data(), n, s3.data(), 77);
+            for (size_t i = 0; i < n; ++i) {
+                Vec3 p(xs[i], ys[i], zs[i]);
+                assert(p2[i] == Perlin(xs[i], ys[i], 77));
+                assert(p3[i] == Perlin(p, 77));
+                assert(s2[i] == Simplex(xs[i], ys[i], 77));
+                assert(s3[i] == Simplex(p, 77));
+            }
+            assert(p2[n] == Unit(42) && p3[n] == Unit(42) && s2[n] == Unit(42) && s3[n] == Unit(42));
+        }
+    }
+
+    TestNoise() {
+        TestLattice();
+        TestShape();
+        TestBatch();
+    }
+};
+
+static TestNoise __test_noise;
+
+int main(void) {}
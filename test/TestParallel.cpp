@@ -0,0 +1,161 @@
+#include "gekko_math.h"
+#include "gekko_parallel.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct Bounds {
+    Vec3 min;
+    Vec3 max;
+};
+
+struct TestParallel {
+    std::vector<Vec3> pos;
+    std::vector<Vec3> vel;
+
+    TestParallel() {
+        uint32_t state = 12345;
+        auto next = [&] {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<int32_t>(state >> 8) - (1 << 23);   // +-256 units
+        };
+        for (int i = 0; i < 10007; ++i) {
+            pos.push_back(Vec3(Unit::From(next()), Unit::From(next()), Unit::From(next())));
+            vel.push_back(Vec3(Unit::From(next() / 64), Unit::From(next() / 64), Unit::From(next() / 64)));
+        }
+
+        TestParallelFor();
+        TestReduceDeterminism();
+        TestEdgeCases();
+    }
+
+    static Bounds Union(const Bounds& a, const Bounds& b) {
+        return Bounds{
+            Vec3(Min(a.min.x, b.min.x), Min(a.min.y, b.min.y), Min(a.min.z, b.min.z)),
+            Vec3(Max(a.max.x, b.max.x), Max(a.max.y, b.max.y), Max(a.max.z, b.max.z)) };
+    }
+
+    void TestParallelFor() {
+        const Unit dt = Unit::From(Unit::ONE / 60);
+        std::vector<Vec3> expected = pos;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            expected[i] += vel[i] * dt;
+        }
+
+        for (uint32_t workers : { 0u, 1u, 3u, 8u }) {
+            ThreadPool pool(workers);
+            std::vector<Vec3> p = pos;
+            std::vector<int> hits(p.size(), 0);
+            ParallelFor(pool, p.size(), 100, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    p[i] += vel[i] * dt;
+                    hits[i]++;
+                }
+            });
+            assert(p == expected);
+            for (int h : hits) {
+                assert(h == 1);
+            }
+        }
+    }
+
+    void TestReduceDeterminism() {
+        const Unit half = Unit::From(Unit::HALF);
+        const Bounds empty{ pos[0], pos[0] };
+
+        // 10007 terms of up to 24 units overflow a Unit, so the partials are raw int64 sums
+        auto energy = [&](ThreadPool& pool) {
+            return ParallelReduce(pool, vel.size(), 256, int64_t(0), [&](size_t begin, size_t end) {
+                int64_t e = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    e += (vel[i].Dot(vel[i]) * half).Raw();
+                }
+                return e;
+            }, [](int64_t a, int64_t b) { return a + b; });
+        };
+        auto bounds = [&](ThreadPool& pool) {
+            return ParallelReduce(pool, pos.size(), 333, empty, [&](size_t begin, size_t end) {
+                Bounds b{ pos[begin], pos[begin] };
+                for (size_t i = begin; i < end; ++i) {
+                    b = Union(b, Bounds{ pos[i], pos[i] });
+                }
+                return b;
+            }, Union);
+        };
+        // float addition is not associative, only a fixed combine order makes it reproducible
+        auto float_sum = [&](ThreadPool& pool) {
+            return ParallelReduce(pool, pos.size(), 64, 0.0f, [&](size_t begin, size_t end) {
+                float s = 0.0f;
+                for (size_t i = begin; i < end; ++i) {
+                    s += pos[i].x.AsFloat() * 1.37f;
+                }
+                return s;
+            }, [](float a, float b) { return a + b; });
+        };
+        // rounding combine: the order matters bit for bit
+        auto rounded = [&](ThreadPool& pool) {
+            return ParallelReduce(pool, pos.size(), 50, Unit(1), [&](size_t begin, size_t) {
+                return Unit::From(Unit::ONE + (pos[begin].x.Raw() & 0x3FF));
+            }, [](Unit a, Unit b) { return Unit::From((a * b).Raw() & 0x7FFFF); });
+        };
+
+        ThreadPool serial(0);
+        const int64_t e0 = energy(serial);
+        const Bounds b0 = bounds(serial);
+        const float f0 = float_sum(serial);
+        const Unit r0 = rounded(serial);
+
+        int64_t e = 0;
+        for (const Vec3& v : vel) {
+            e += (v.Dot(v) * half).Raw();
+        }
+        assert(e0 == e);
+
+        Bounds full{ pos[0], pos[0] };
+        for (const Vec3& p : pos) {
+            full = Union(full, Bounds{ p, p });
+        }
+        assert(b0.min == full.min && b0.max == full.max);
+
+        for (uint32_t workers : { 1u, 2u, 3u, 5u, 8u }) {
+            ThreadPool pool(workers);
+            for (int repeat = 0; repeat < 4; ++repeat) {
+                assert(energy(pool) == e0);
+                Bounds b = bounds(pool);
+                assert(b.min == b0.min && b.max == b0.max);
+                float f = float_sum(pool);
+                assert(std::memcmp(&f, &f0, sizeof(float)) == 0);
+                assert(rounded(pool) == r0);
+            }
+        }
+
+        // partials live in the arena only for the duration of the call
+        assert(ThreadArena().Used() == 0);
+    }
+
+    void TestEdgeCases() {
+        ThreadPool pool(2);
+        int calls = 0;
+        ParallelFor(pool, 0, 16, [&](size_t, size_t) { calls++; });
+        assert(calls == 0);
+
+        Unit none = ParallelReduce(pool, 0, 16, Unit(7), [](size_t, size_t) { return Unit(1); },
+            [](Unit a, Unit b) { return a + b; });
+        assert(none == 7);
+
+        Unit small = ParallelReduce(pool, 5, 16, Unit(0), [](size_t begin, size_t end) {
+            return Unit(static_cast<int32_t>(end - begin));
+        }, [](Unit a, Unit b) { return a + b; });
+        assert(small == 5);
+
+        assert(ChunkCount(10, 3) == 4);
+        assert(ChunkCount(10, 0) == 10);
+    }
+};
+
+static TestParallel __test_parallel;
+
+int main(void) {}
@@ -0,0 +1,116 @@
+#include "gekko_profile.h"
+#include "gekko_math.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Gekko::Math;
+using namespace Gekko::Profile;
+
+struct TestProfile {
+    static void Work(int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            GEKKO_PROFILE_ZONE("outer");
+            Unit u = Unit::SqrtNewton(Unit(i + 1));
+            {
+                GEKKO_PROFILE_ZONE("inner");
+                u = u * u;
+            }
+            assert(u.Raw() > 0);
+        }
+    }
+
+    static size_t Count(const std::vector<Profiler::Record>& records, const char* name) {
+        size_t n = 0;
+        for (const auto& r : records) {
+            n += std::strcmp(r.event.name, name) == 0;
+        }
+        return n;
+    }
+
+    void TestNotRecording() {
+        Work(10);
+        Profiler::Get().Start();
+        Profiler::Get().Stop();
+        assert(Profiler::Get().Records().empty());
+    }
+
+    void TestThreads() {
+        const int threads = 4;
+        const int iterations = 1000;
+
+        Profiler::Get().Start();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back(Work, iterations);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        Profiler::Get().Stop();
+
+        auto records = Profiler::Get().Records();
+        assert(Profiler::Get().Dropped() == 0);
+        assert(Count(records, "outer") == threads * iterations);
+        assert(Count(records, "inner") == threads * iterations);
+        for (const auto& r : records) {
+            assert(r.event.begin <= r.event.end);
+            assert(r.tid != 0);
+        }
+
+        // every inner zone lies inside an outer zone of the same thread
+        for (const auto& inner : records) {
+            if (std::strcmp(inner.event.name, "inner") != 0) {
+                continue;
+            }
+            bool nested = false;
+            for (const auto& outer : records) {
+                if (outer.tid == inner.tid && std::strcmp(outer.event.name, "outer") == 0 &&
+                    outer.event.begin <= inner.event.begin && inner.event.end <= outer.event.end) {
+                    nested = true;
+                    break;
+                }
+            }
+            assert(nested);
+            (void)nested;
+        }
+    }
+
+    void TestChromeTrace() {
+        Profiler::Get().Start();
+        Work(100);
+        Profiler::Get().Stop();
+
+        const std::string path = "gekko_profile_test.json";
+        assert(Profiler::Get().WriteChromeTrace(path));
+        std::ifstream in(path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::string json = ss.str();
+        std::remove(path.c_str());
+
+        assert(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+        size_t events = 0;
+        for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos; at = json.find("\"ph\":\"X\"", at + 1)) {
+            events++;
+        }
+        assert(events == 200);
+        assert(json.find("\"name\":\"inner\"") != std::string::npos);
+    }
+
+    TestProfile() {
+        TestNotRecording();
+        TestThreads();
+        TestChromeTrace();
+    }
+};
+
+static TestProfile __test_profile;
+
+int main(void) {}
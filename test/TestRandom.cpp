@@ -0,0 +1,224 @@
+#include "gekko_math.h"
+#include "gekko_random.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestRandom {
+    static const size_t MAX_COUNT = 37;
+
+    // straight from the xoshiro128** reference implementation
+    struct Reference {
+        uint32_t s[4];
+
+        static uint32_t rotl(const uint32_t x, int k) {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        uint32_t next(void) {
+            const uint32_t result = rotl(s[1] * 5, 7) * 9;
+            const uint32_t t = s[1] << 9;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 11);
+            return result;
+        }
+    };
+
+    void TestSequence() {
+        Random rng;
+        rng.SetState(1, 2, 3, 4);
+        Reference ref{ { 1, 2, 3, 4 } };
+        assert(rng.Next() == 11520 && ref.next() == 11520);
+        for (int i = 0; i < 1000; ++i) {
+            assert(rng.Next() == ref.next());
+        }
+
+        // same seed, same sequence; a copy is a snapshot
+        Random a(1234), b(1234), c(1235);
+        assert(a == b && a != c);
+        for (int i = 0; i < 10; ++i) {
+            a.Next();
+        }
+        Random snapshot = a;
+        uint32_t expected = a.Next();
+        assert(snapshot.Next() == expected && snapshot == a);
+
+        // an all-zero state would never leave zero
+        Random zero;
+        zero.SetState(0, 0, 0, 0);
+        assert(zero.Next() != 0 || zero.Next() != 0);
+    }
+
+    void TestRanges() {
+        Random rng(7);
+        for (int i = 0; i < 10000; ++i) {
+            Unit u = rng.NextUnit();
+            assert(u >= Unit(0) && u < Unit(1));
+            Unit r = rng.Range(Unit(-3), Unit(5));
+            assert(r >= Unit(-3) && r < Unit(5));
+            assert(rng.Below(10) < 10);
+        }
+        assert(rng.Range(Unit(2), Unit(2)) == Unit(2));
+        assert(rng.Range(Unit(2), Unit(1)) == Unit(2));
+        assert(rng.Below(0) == 0);
+
+        // the full raw range, no overflow
+        Unit lo = Unit::From(INT32_MIN), hi = Unit::From(INT32_MAX);
+        bool negative = false, positive = false;
+        for (int i = 0; i < 100; ++i) {
+            Unit r = rng.Range(lo, hi);
+            assert(r >= lo && r < hi);
+            negative |= r < Unit(0);
+            positive |= r > Unit(0);
+        }
+        assert(negative && positive);
+
+        // four LSBs wide: every value is reached with about equal frequency
+        int hits[4] = {};
+        for (int i = 0; i < 40000; ++i) {
+            hits[rng.Range(Unit::From(100), Unit::From(104)).Raw() - 100]++;
+        }
+        for (int h : hits) {
+            assert(h > 9000 && h < 11000);
+        }
+    }
+
+    void TestShapes() {
+        Random rng(99);
+        const Unit radius = Unit(3);
+        Vec3 min(Unit(-1), Unit(2), Unit(-10)), max(Unit(1), Unit(3), Unit(10));
+        for (int i = 0; i < 2000; ++i) {
+            Vec3 s = rng.InSphere(radius);
+            assert(s.Dot(s) <= radius * radius + Unit::From(64));
+
+            Vec3 d = rng.InDisc(radius);
+            assert(d.z == Unit(0) && d.Dot(d) <= radius * radius + Unit::From(64));
+
+            Vec3 b = rng.InBox(min, max);
+            assert(b.x >= min.x && b.x < max.x && b.y >= min.y && b.y < max.y && b.z >= min.z && b.z < max.z);
+
+            Vec3 dir = rng.Direction();
+            Unit len2 = dir.Dot(dir);
+            assert(len2 > Unit::From(Unit::ONE - 64) && len2 < Unit::From(Unit::ONE + 64));
+        }
+
+        // directions cover all octants about equally
+        int octants[8] = {};
+        for (int i = 0; i < 8000; ++i) {
+            Vec3 d = rng.Direction();
+            octants[(d.x < Unit(0)) | (d.y < Unit(0)) << 1 | (d.z < Unit(0)) << 2]++;
+        }
+        for (int o : octants) {
+            assert(o > 800 && o < 1200);
+        }
+    }
+
+    void TestGaussian() {
+        Random rng(5);
+        const int n = 20000;
+        double sum = 0, sum2 = 0;
+        for (int i = 0; i < n; ++i) {
+            Unit g = rng.Gaussian();
+            assert(g >= Unit(-6) && g < Unit(6));
+            double v = g.AsFloat();
+            sum += v;
+            sum2 += v * v;
+        }
+        double mean = sum / n, var = sum2 / n - mean * mean;
+        assert(mean > -0.05 && mean < 0.05);
+        assert(var > 0.95 && var < 1.05);
+
+        Random a(11), b(11);
+        for (int i = 0; i < 100; ++i) {
+            assert(a.Gaussian(Unit(10), Unit(2)) == Unit(10) + b.Gaussian() * Unit(2));
+        }
+    }
+
+    // fill i comes from lane i % 4, every fill advances the lanes by whole steps
+    void TestBatch() {
+        for (size_t n = 0; n <= MAX_COUNT; ++n) {
+            RandomBatch batch(n);
+            Random lanes[4];
+            for (uint32_t k = 0; k < 4; ++k) {
+                lanes[k] = batch.Lane(k);
+            }
+
+            std::vector<uint32_t> bits(n + 1, 42);
+            batch.Fill(bits.data(), n);
+            std::vector<Unit> units(n + 1, Unit(42));
+            batch.FillUnit(units.data(), n);
+            std::vector<Unit> range(n);
+            batch.FillRange(range.data(), n, Unit(-5), Unit(7));
+            std::vector<Vec3> box(n);
+            Vec3 min(Unit(-1), Unit(0), Unit(100)), max(Unit(1), Unit(50), Unit(101));
+            batch.FillInBox(box.data(), n, min, max);
+            std::vector<Unit> gauss(n);
+            batch.FillGaussian(gauss.data(), n, Unit(1), Unit::From(Unit::HALF));
+            assert(bits[n] == 42 && units[n] == Unit(42));
+
+            const size_t groups = (n + 3) / 4;
+            for (uint32_t k = 0; k < 4; ++k) {
+                Random& r = lanes[k];
+                for (size_t g = 0; g < groups; ++g) {
+                    uint32_t v = r.Next();
+                    if (4 * g + k < n) {
+                        assert(bits[4 * g + k] == v);
+                    }
+                }
+                for (size_t g = 0; g < groups; ++g) {
+                    Unit v = r.NextUnit();
+                    if (4 * g + k < n) {
+                        assert(units[4 * g + k] == v);
+                    }
+                }
+                for (size_t g = 0; g < groups; ++g) {
+                    Unit v = r.Range(Unit(-5), Unit(7));
+                    if (4 * g + k < n) {
+                        assert(range[4 * g + k] == v);
+                    }
+                }
+                for (size_t g = 0; g < groups; ++g) {
+                    Vec3 v = r.InBox(min, max);
+                    if (4 * g + k < n) {
+                        assert(box[4 * g + k] == v);
+                    }
+                }
+                for (size_t g = 0; g < groups; ++g) {
+                    Unit v = r.Gaussian(Unit(1), Unit::From(Unit::HALF));
+                    if (4 * g + k < n) {
+                        assert(gauss[4 * g + k] == v);
+                    }
+                }
+                assert(r == batch.Lane(k));
+            }
+        }
+
+        // snapshots of the batch state
+        RandomBatch a(3);
+        RandomBatch copy = a;
+        Unit x[9], y[9];
+        a.FillRange(x, 9, Unit(0), Unit(1000));
+        copy.FillRange(y, 9, Unit(0), Unit(1000));
+        assert(a == copy && std::memcmp(x, y, sizeof(x)) == 0);
+        assert(a != RandomBatch(4));
+    }
+
+    TestRandom() {
+        TestSequence();
+        TestRanges();
+        TestShapes();
+        TestGaussian();
+        TestBatch();
+    }
+};
+
+static TestRandom __test_random;
+
+int main(void) {}
@@ -0,0 +1,133 @@
+#include "gekko_math.h"
+#include "gekko_render_channel.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestRenderChannel {
+    static std::vector<Vec3> Positions(uint64_t id, size_t count) {
+        std::vector<Vec3> p(count);
+        for (size_t i = 0; i < count; ++i) {
+            int32_t base = static_cast<int32_t>(id % 1000) * Unit::ONE;
+            p[i] = Vec3(Unit::From(base), Unit::From(base + static_cast<int32_t>(i)), Unit::From(-base));
+        }
+        return p;
+    }
+
+    // every element was written by the same Publish
+    static bool Consistent(const RenderChannel::Frame& f) {
+        const float expected = static_cast<float>(f.id % 1000);
+        for (size_t i = 0; i < f.count; ++i) {
+            if (f.data[i].x != expected || f.data[i].z != -expected ||
+                f.data[i].y != expected + static_cast<float>(i) / Unit::ONE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TestConvert() {
+        std::vector<Vec3> in = Positions(7, 100);
+        in[3] = Vec3(Unit::From(-1), Unit::From(0x7FFFFFFF), Unit::From(-0x7FFFFFFF - 1));
+        std::vector<Vec3F> out(in.size());
+        AsFloat(in.data(), in.size(), out.data());
+        for (size_t i = 0; i < in.size(); ++i) {
+            Vec3F f = in[i].AsFloat();
+            assert(out[i].x == f.x && out[i].y == f.y && out[i].z == f.z);
+        }
+
+        Unit units[3] = { Unit(1), Unit::From(Unit::HALF), Unit(-4) };
+        float floats[3];
+        AsFloat(units, 3, floats);
+        assert(floats[0] == 1.0f && floats[1] == 0.5f && floats[2] == -4.0f);
+    }
+
+    void TestSequence() {
+        RenderChannel channel(64);
+        assert(channel.Acquire() == nullptr);
+        assert(!channel.HasNew());
+
+        std::vector<Vec3> p1 = Positions(1, 10);
+        channel.Publish(p1.data(), p1.size(), 1);
+        assert(channel.HasNew());
+        const RenderChannel::Frame* f = channel.Acquire();
+        assert(f && f->id == 1 && f->count == 10 && Consistent(*f));
+        assert(!channel.HasNew());
+
+        // frames the consumer did not pick up are skipped, the newest one wins
+        std::vector<Vec3> p2 = Positions(2, 20);
+        std::vector<Vec3> p3 = Positions(3, 30);
+        channel.Publish(p2.data(), p2.size(), 2);
+        channel.Publish(p3.data(), p3.size(), 3);
+        f = channel.Acquire();
+        assert(f->id == 3 && f->count == 30 && Consistent(*f));
+
+        // nothing new: the held frame stays
+        f = channel.Acquire();
+        assert(f->id == 3);
+
+        // the count is clamped to the capacity
+        std::vector<Vec3> big = Positions(4, 100);
+        channel.Publish(big.data(), big.size(), 4);
+        f = channel.Acquire();
+        assert(f->id == 4 && f->count == 64 && Consistent(*f));
+
+        // filling the back buffer directly
+        RenderChannel::Frame& back = channel.Back();
+        back.count = 1;
+        back.id = 5;
+        back.data[0] = Vec3F(5.0f, 5.0f, -5.0f);
+        channel.Publish();
+        f = channel.Acquire();
+        assert(f->id == 5 && Consistent(*f));
+    }
+
+    void TestThreads() {
+        const uint64_t frames = 20000;
+        const size_t count = 256;
+        RenderChannel channel(count);
+        std::atomic<bool> done{ false };
+
+        std::thread producer([&] {
+            std::vector<Vec3> p(count);
+            for (uint64_t id = 1; id <= frames; ++id) {
+                p = Positions(id, count);
+                channel.Publish(p.data(), p.size(), id);
+            }
+            done = true;
+        });
+
+        uint64_t last = 0;
+        uint64_t seen = 0;
+        for (;;) {
+            bool finished = done.load();
+            const RenderChannel::Frame* f = channel.Acquire();
+            if (f) {
+                assert(f->id >= last);
+                assert(f->count == count);
+                assert(Consistent(*f));
+                seen += f->id != last;
+                last = f->id;
+            }
+            if (finished && last == frames) {
+                break;
+            }
+        }
+        producer.join();
+        assert(last == frames && seen > 0);
+    }
+
+    TestRenderChannel() {
+        TestConvert();
+        TestSequence();
+        TestThreads();
+    }
+};
+
+static TestRenderChannel __test_render_channel;
+
+int main(void) {}
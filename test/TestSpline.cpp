@@ -0,0 +1,194 @@
+#include "gekko_math.h"
+#include "gekko_spline.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Gekko::Math;
+
+struct TestSpline {
+    static const SplineKind KINDS[2];
+
+    // 'count' points within 16 units of the origin
+    static std::vector<Vec3> Points(uint32_t seed, uint32_t count) {
+        std::vector<Vec3> points(count);
+        uint32_t h = seed;
+        auto next = [&h]() {
+            h = h * 1664525u + 1013904223u;
+            return Unit::From(static_cast<int32_t>(h >> 8) % (16 * Unit::ONE));
+        };
+        for (Vec3& p : points) {
+            p.x = next();
+            p.y = next();
+            p.z = next();
+        }
+        return points;
+    }
+
+    static bool Near(const Vec3& a, const Vec3& b, int32_t lsb) {
+        return std::abs(a.x.Raw() - b.x.Raw()) <= lsb && std::abs(a.y.Raw() - b.y.Raw()) <= lsb && std::abs(a.z.Raw() - b.z.Raw()) <= lsb;
+    }
+
+    static double Length(const Vec3& v) {
+        const double x = v.x.Raw(), y = v.y.Raw(), z = v.z.Raw();
+        return std::sqrt(x * x + y * y + z * z) / Unit::ONE;
+    }
+
+    // Bezier splines hit every third point, Catmull-Rom every point; parameters clamp
+    void TestEndpoints() {
+        std::vector<Vec3> points = Points(1, 10);
+        Spline bezier(points.data(), 10, SplineKind::Bezier), catmull(points.data(), 10, SplineKind::CatmullRom);
+        assert(bezier.Segments() == 3 && catmull.Segments() == 9);
+        for (uint32_t s = 0; s <= 3; ++s) {
+            assert(bezier.Evaluate(Unit(static_cast<int32_t>(s))) == points[3 * s]);
+        }
+        for (uint32_t s = 0; s <= 9; ++s) {
+            assert(catmull.Evaluate(Unit(static_cast<int32_t>(s))) == points[s]);
+        }
+        assert(bezier.Evaluate(Unit(-4)) == points[0] && bezier.Evaluate(Unit(40)) == points[9]);
+        assert(catmull.Evaluate(Unit::From(INT32_MIN)) == points[0] && catmull.Evaluate(Unit::From(INT32_MAX)) == points[9]);
+
+        // the empty spline evaluates to the origin
+        const Vec3 origin(Unit(0), Unit(0), Unit(0));
+        assert(Spline().Segments() == 0 && Spline().Evaluate(Unit(1)) == origin);
+    }
+
+    void TestShapes() {
+        // control points on a line at thirds trace the line at constant speed
+        const Vec3 line[] = { Vec3(Unit(0), Unit(0), Unit(0)), Vec3(Unit(1), Unit(2), Unit(3)), Vec3(Unit(2), Unit(4), Unit(6)),
+            Vec3(Unit(3), Unit(6), Unit(9)) };
+        Spline bezier(line, 4, SplineKind::Bezier), catmull(line, 4, SplineKind::CatmullRom);
+        for (int32_t raw = 0; raw <= Unit::ONE; raw += 97) {
+            const Unit u = Unit::From(raw);
+            assert(Near(bezier.Evaluate(u), Vec3(u * Unit(3), u * Unit(6), u * Unit(9)), 1));
+            assert(Near(bezier.Tangent(u), Vec3(Unit(3), Unit(6), Unit(9)), 2));
+            assert(Near(catmull.Evaluate(u + Unit(1)), line[1] + Vec3(u, u * Unit(2), u * Unit(3)), 1));
+        }
+
+        // Catmull-Rom tangents are half the difference of the neighbours
+        std::vector<Vec3> points = Points(2, 6);
+        Spline spline(points.data(), 6, SplineKind::CatmullRom);
+        for (uint32_t i = 1; i < 5; ++i) {
+            const Vec3 expected = (points[i + 1] - points[i - 1]) / Unit(2);
+            assert(Near(spline.Tangent(Unit(static_cast<int32_t>(i))), expected, 1));
+        }
+    }
+
+    // forward differences land on Evaluate, exactly at the segment ends, for any step count
+    void TestTessellate() {
+        std::vector<Vec3> points = Points(3, 13);
+        const uint32_t steps[] = { 1, 3, 7, 16, 100, 256 };
+        for (SplineKind kind : KINDS) {
+            Spline spline(points.data(), 13, kind);
+            for (uint32_t n : steps) {
+                std::vector<Vec3> out(ArcLengthTable::Entries(spline, n) + 1);
+                out.back() = Vec3(Unit(42), Unit(42), Unit(42));
+                spline.Tessellate(n, out.data());
+                assert(out.back() == Vec3(Unit(42), Unit(42), Unit(42)));
+                for (uint32_t k = 0; k + 1 < out.size(); ++k) {
+                    const int64_t raw = (static_cast<int64_t>(k) * Unit::ONE + n / 2) / n;
+                    // k / n is rounded to a parameter LSB, which moves the point by up to half the tangent
+                    const Unit s = Unit::From(static_cast<int32_t>(raw));
+                    const Vec3 d = spline.Tangent(s);
+                    const int32_t slope = std::abs(d.x.Raw()) + std::abs(d.y.Raw()) + std::abs(d.z.Raw());
+                    assert(Near(out[k], spline.Evaluate(s), 2 + (n & (n - 1) ? slope / Unit::ONE : 0)));
+                    if (k % n == 0) {
+                        assert(out[k] == spline.Evaluate(Unit(static_cast<int32_t>(k / n))));
+                    }
+                }
+            }
+        }
+    }
+
+    // distances are monotonic, match the float polyline and map back to evenly spaced points
+    void TestArcLength() {
+        std::vector<Vec3> points = Points(4, 7);
+        for (SplineKind kind : KINDS) {
+            Spline spline(points.data(), 7, kind);
+            const uint32_t steps = 128;
+            std::vector<Unit> lengths(ArcLengthTable::Entries(spline, steps));
+            ArcLengthTable table(spline, steps, lengths.data());
+            std::vector<Vec3> samples(lengths.size());
+            spline.Tessellate(steps, samples.data());
+            double total = 0;
+            for (size_t i = 1; i < lengths.size(); ++i) {
+                assert(lengths[i] >= lengths[i - 1]);
+                total += Length(samples[i] - samples[i - 1]);
+            }
+            assert(std::abs(table.Length().AsFloat() - total) < 0.01);
+
+            // entry distances map back to the sample parameters
+            for (uint32_t i = 0; i < lengths.size(); i += 5) {
+                const int32_t expected = static_cast<int32_t>((static_cast<int64_t>(i) * Unit::ONE + steps / 2) / steps);
+                assert(std::abs(table.Parameter(lengths[i]).Raw() - expected) <= 1);
+            }
+
+            // constant speed: equal distance steps cover equal arcs, measured along the curve
+            TrackCursor cursor;
+            const Unit step = table.Length() / Unit(200);
+            assert(table.Evaluate(Unit(0), cursor) == points[0]);
+            Unit s0 = Unit(0);
+            for (int i = 1; i <= 200; ++i) {
+                const Unit s1 = table.Parameter(step * Unit(i), cursor);
+                double arc = 0;
+                Vec3 previous = spline.Evaluate(s0);
+                for (int k = 1; k <= 64; ++k) {
+                    const Vec3 p = spline.Evaluate(Unit::From(s0.Raw() + static_cast<int32_t>(static_cast<int64_t>((s1 - s0).Raw()) * k / 64)));
+                    arc += Length(p - previous);
+                    previous = p;
+                }
+                assert(std::abs(arc - step.AsFloat()) < 0.02 * step.AsFloat());
+                s0 = s1;
+            }
+            assert(table.Parameter(table.Length() + Unit(10)) == Unit(static_cast<int32_t>(spline.Segments())));
+            assert(table.Parameter(Unit(-3)) == Unit(0));
+        }
+
+        // a degenerate spline has zero length, no division by it, and clamps like any other
+        const Vec3 same[] = { Vec3(Unit(1), Unit(1), Unit(1)), Vec3(Unit(1), Unit(1), Unit(1)) };
+        Spline still(same, 2, SplineKind::CatmullRom);
+        Unit lengths[9];
+        ArcLengthTable table(still, 8, lengths);
+        assert(table.Length() == Unit(0) && table.Parameter(Unit(1)) == Unit(1) && table.Parameter(Unit(-1)) == Unit(0));
+    }
+
+    // the closest point matches a dense float scan
+    void TestClosest() {
+        std::vector<Vec3> points = Points(5, 8);
+        uint32_t h = 9;
+        for (SplineKind kind : KINDS) {
+            Spline spline(points.data(), kind == SplineKind::Bezier ? 7 : 8, kind);
+            const uint32_t dense = 4096;
+            for (int i = 0; i < 40; ++i) {
+                h = h * 1664525u + 1013904223u;
+                const Vec3 q(Unit::From(static_cast<int32_t>(h >> 12)), Unit::From(static_cast<int32_t>(h >> 13)), Unit::From(static_cast<int32_t>(h >> 14)));
+                double best = 1e30;
+                for (uint32_t s = 0; s < spline.Segments(); ++s) {
+                    for (uint32_t k = 0; k <= dense; ++k) {
+                        const Unit t = Unit::From(static_cast<int32_t>(s * Unit::ONE + k * Unit::ONE / dense));
+                        const double d = Length(spline.Evaluate(t) - q);
+                        best = d < best ? d : best;
+                    }
+                }
+                const Unit s = spline.Closest(q, 32);
+                assert(Length(spline.Evaluate(s) - q) <= best + 0.002);
+            }
+        }
+    }
+
+    TestSpline() {
+        TestEndpoints();
+        TestShapes();
+        TestTessellate();
+        TestArcLength();
+        TestClosest();
+    }
+};
+
+const SplineKind TestSpline::KINDS[2] = { SplineKind::Bezier, SplineKind::CatmullRom };
+
+static TestSpline __test_spline;
+
+int main(void) {}
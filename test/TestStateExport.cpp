@@ -0,0 +1,216 @@
+#include "gekko_math.h"
+#include "gekko_state_export.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(GEKKO_STATE_EXPORT_POSIX)
+#include <sys/wait.h>
+#endif
+
+using namespace Gekko::Math;
+
+struct TestStateExport {
+    struct Block {
+        void* data;
+        size_t size;
+
+        explicit Block(size_t bytes) : data(::operator new(bytes, std::align_val_t(64))), size(bytes) {
+            std::memset(data, 0, bytes);
+        }
+
+        ~Block() {
+            ::operator delete(data, std::align_val_t(64));
+        }
+    };
+
+    static std::vector<Vec3> Positions(uint64_t id, size_t count) {
+        std::vector<Vec3> p(count);
+        for (size_t i = 0; i < count; ++i) {
+            int32_t base = static_cast<int32_t>(id % 1000) * Unit::ONE;
+            p[i] = Vec3(Unit::From(base), Unit::From(base + static_cast<int32_t>(i)), Unit::From(-base));
+        }
+        return p;
+    }
+
+    // every element was written by the same Publish, raw and float streams agree
+    static bool Consistent(const StateFrame& f) {
+        const int32_t base = static_cast<int32_t>(f.id % 1000) * Unit::ONE;
+        for (uint32_t i = 0; i < f.count; ++i) {
+            if (f.x[i] != base || f.y[i] != base + static_cast<int32_t>(i) || f.z[i] != -base) {
+                return false;
+            }
+            if (f.fx[i] != Unit::From(f.x[i]).AsFloat() || f.fy[i] != Unit::From(f.y[i]).AsFloat() ||
+                f.fz[i] != Unit::From(f.z[i]).AsFloat()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TestSequence() {
+        Block block(StateExport::Bytes(3, 64));
+        StateView early(block.data, block.size);
+        assert(!early.Valid());
+
+        StateExport out(block.data, block.size, 3, 64);
+        assert(out.Valid() && out.Capacity() == 64);
+        StateView in(block.data, block.size);
+        assert(in.Valid() && in.Capacity() == 64);
+        StateFrame f;
+        assert(!in.Latest(f));
+        assert(!in.Read([](const StateFrame&) {}));
+
+        std::vector<Vec3> p1 = Positions(1, 10);
+        out.Publish(p1.data(), 10, 1);
+        assert(in.Latest(f) && f.id == 1 && f.count == 10 && Consistent(f) && in.Validate(f));
+
+        // the held view stays valid until the writer comes back around to its slot
+        std::vector<Vec3> p2 = Positions(2, 20);
+        std::vector<Vec3> p3 = Positions(3, 30);
+        out.Publish(p2.data(), 20, 2);
+        out.Publish(p3.data(), 30, 3);
+        assert(in.Validate(f) && Consistent(f));
+        std::vector<Vec3> p4 = Positions(4, 40);
+        out.Publish(p4.data(), 40, 4);
+        assert(!in.Validate(f));
+        assert(in.Published() == 4);
+
+        StateFrame latest;
+        assert(in.Latest(latest) && latest.id == 4 && latest.count == 40 && Consistent(latest));
+
+        // the count is clamped to the capacity
+        std::vector<Vec3> big = Positions(5, 100);
+        out.Publish(big.data(), 100, 5);
+        assert(in.Read([](const StateFrame& fr) { assert(fr.id == 5 && fr.count == 64 && Consistent(fr)); }));
+
+        // SoA input
+        std::vector<Vec3> p6 = Positions(6, 17);
+        std::vector<Unit> xs, ys, zs;
+        for (const Vec3& v : p6) {
+            xs.push_back(v.x);
+            ys.push_back(v.y);
+            zs.push_back(v.z);
+        }
+        out.Publish(xs.data(), ys.data(), zs.data(), 17, 6);
+        assert(in.Latest(f) && f.id == 6 && f.count == 17 && Consistent(f));
+    }
+
+    void TestAttach() {
+        Block block(StateExport::Bytes(2, 8));
+        StateExport out(block.data, block.size, 2, 8);
+        assert(StateView(block.data, block.size).Valid());
+        assert(!StateView(block.data, block.size - 1).Valid());
+        assert(!StateView(nullptr, 0).Valid());
+
+        Block empty(StateExport::Bytes(2, 8));
+        StateView in(empty.data, empty.size);
+        assert(!in.Valid());
+        StateExport late(empty.data, empty.size, 2, 8);
+        assert(in.Attach(empty.data, empty.size) && in.Valid());
+    }
+
+    // a reader polling while the writer publishes never accepts a torn frame
+    void TestConcurrent() {
+        const uint32_t capacity = 256;
+        Block block(StateExport::Bytes(2, capacity));
+        StateExport out(block.data, block.size, 2, capacity);
+        StateView in(block.data, block.size);
+        std::atomic<bool> done{ false };
+
+        std::thread reader([&] {
+            uint64_t last = 0;
+            std::vector<int32_t> copy(capacity);
+            while (!done.load(std::memory_order_acquire)) {
+                StateFrame f;
+                if (!in.Latest(f)) {
+                    continue;
+                }
+                uint64_t id = f.id;
+                uint32_t count = f.count;
+                std::memcpy(copy.data(), f.y, sizeof(int32_t) * count);
+                if (!in.Validate(f)) {
+                    continue;
+                }
+                assert(id >= last);
+                last = id;
+                const int32_t base = static_cast<int32_t>(id % 1000) * Unit::ONE;
+                for (uint32_t i = 0; i < count; ++i) {
+                    assert(copy[i] == base + static_cast<int32_t>(i));
+                }
+            }
+        });
+
+        for (uint64_t id = 1; id <= 5000; ++id) {
+            std::vector<Vec3> p = Positions(id, 1 + id % capacity);
+            out.Publish(p.data(), static_cast<uint32_t>(p.size()), id);
+        }
+        done.store(true, std::memory_order_release);
+        reader.join();
+    }
+
+#if defined(GEKKO_STATE_EXPORT_POSIX)
+    // a separate process maps the block read-only and sees the published frame
+    void TestSharedMemory() {
+        const std::string name = "/gekko_test_state_" + std::to_string(getpid());
+        SharedMemory missing = SharedMemory::Open(name.c_str());
+        assert(!missing.Valid());
+
+        SharedMemory shm = SharedMemory::Create(name.c_str(), StateExport::Bytes(4, 32));
+        assert(shm.Valid() && shm.Size() == StateExport::Bytes(4, 32));
+        StateExport out(shm.Data(), shm.Size(), 4, 32);
+        std::vector<Vec3> p = Positions(42, 32);
+        out.Publish(p.data(), 32, 42);
+
+        // a live name is not taken over unless asked, and an overlong one creates nothing
+        assert(!SharedMemory::Create(name.c_str(), StateExport::Bytes(4, 32)).Valid());
+        assert(SharedMemory::Open(name.c_str()).Valid());
+        const std::string long_name = "/" + std::string(255, 'g');
+        assert(!SharedMemory::Create(long_name.c_str(), 4096).Valid() && !SharedMemory::Open(long_name.c_str()).Valid());
+
+        pid_t child = fork();
+        if (child == 0) {
+            SharedMemory view = SharedMemory::Open(name.c_str());
+            StateView in(view.Data(), view.Size());
+            bool ok = view.Valid() && in.Valid() &&
+                in.Read([](const StateFrame& f) { assert(f.id == 42 && f.count == 32 && Consistent(f)); });
+            _exit(ok ? 0 : 1);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        // the creator removes the name
+        {
+            SharedMemory gone = static_cast<SharedMemory&&>(shm);
+        }
+        assert(!SharedMemory::Open(name.c_str()).Valid());
+
+        // replace unlinks a stale object left behind by a crashed creator
+        const int stale = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        assert(stale >= 0);
+        close(stale);
+        assert(!SharedMemory::Create(name.c_str(), 4096).Valid());
+        SharedMemory fresh = SharedMemory::Create(name.c_str(), 4096, true);
+        assert(fresh.Valid() && fresh.Size() == 4096);
+    }
+#endif
+
+    TestStateExport() {
+        TestSequence();
+        TestAttach();
+        TestConcurrent();
+#if defined(GEKKO_STATE_EXPORT_POSIX)
+        TestSharedMemory();
+#endif
+    }
+};
+
+static TestStateExport __test_state_export;
+
+int main(void) {}
@@ -0,0 +1,158 @@
+#include "gekko_math.h"
+
+#include <cassert>
+#include <thread>
+
+#if !defined(GEKKO_MATH_COUNT_OPS)
+#error "TestStats needs GEKKO_MATH_COUNT_OPS"
+#endif
+
+using namespace Gekko::Math;
+
+struct TestStats {
+    void TestCounts() {
+        Stats::Reset();
+        Unit a = 6;
+        Unit b = 2;
+        Unit c = a * b;
+        c = c / b;
+        c *= b;
+        c /= b;
+        Vec3 v(a, b, c);
+        (void)v.Dot(v);
+
+        const Stats::OpCounts& n = Stats::Counters();
+        assert(n.mul == 2 + 3);
+        assert(n.div == 2);
+        assert(n.sqrt == 0);
+        assert(n.newton_iterations == 0);
+
+        Stats::Reset();
+        assert(Unit::SqrtNewton(16) == 4);
+        assert(Stats::Counters().sqrt == 1);
+        assert(Stats::Counters().newton_iterations > 0);
+        // u / x and / 2 per iteration
+        assert(Stats::Counters().div == 2 * Stats::Counters().newton_iterations);
+    }
+
+    void TestScopes() {
+        Stats::Reset();
+        for (int i = 0; i < 3; ++i) {
+            Stats::Scope outer("outer");
+            Unit x = Unit(i) * Unit(2);
+            {
+                Stats::Scope inner("inner");
+                x = x / Unit(3);
+            }
+            (void)x;
+        }
+        Stats::Snapshot s = Stats::SnapshotAndReset();
+        assert(s.total.mul == 3 && s.total.div == 3);
+
+        const Stats::ScopeCounts* outer = s.Find("outer");
+        const Stats::ScopeCounts* inner = s.Find("inner");
+        assert(outer && inner);
+        assert(outer->calls == 3 && inner->calls == 3);
+        assert(outer->ops.mul == 3 && outer->ops.div == 3);   // inclusive
+        assert(inner->ops.mul == 0 && inner->ops.div == 3);
+        assert(!s.scopes_overflowed);
+
+        // the reset cleared the counts but kept the names
+        Stats::Snapshot empty = Stats::Read();
+        assert(empty.total.mul == 0);
+        assert(empty.Find("outer") && empty.Find("outer")->calls == 0);
+    }
+
+    void TestResetInsideScope() {
+        Stats::Reset();
+        {
+            Stats::Scope tick("tick");
+            Unit x = Unit(2) * Unit(3);
+            Stats::Reset();
+            x = x * Unit(2);
+            (void)x;
+        }
+        Stats::Snapshot s = Stats::Read();
+        const Stats::ScopeCounts* tick = s.Find("tick");
+        assert(tick && tick->ops.mul == 1);
+    }
+
+    void TestSqrtHistogram() {
+        Stats::Reset();
+        assert(Unit::SqrtNewton(16) == 4);
+        const Stats::SqrtStats& s = Stats::Sqrt();
+        assert(s.Calls() == 1);
+        assert(s.iterations[Stats::Counters().newton_iterations] == 1);
+        assert(s.cap_hits == 0);
+        // 16.0 is raw 2^19, octave 20
+        assert(s.octave_calls[20] == 1);
+        assert(s.octave_max_iterations[20] == Stats::Counters().newton_iterations);
+
+        // large inputs start far from the root and stop at the cap
+        Unit::SqrtNewton(30000);
+        assert(s.Calls() == 2);
+        assert(s.cap_hits == 1);
+        assert(s.iterations[Unit::SQRT_MAX_ITER] == 1);
+        assert(s.FirstCapOctave() == 30 && s.LastCapOctave() == 30);
+        assert(s.octave_cap_hits[30] == 1);
+
+        // zero returns before iterating
+        Unit::SqrtNewton(0);
+        assert(s.Calls() == 2);
+
+        Stats::Snapshot tick = Stats::SnapshotAndReset();
+        assert(tick.sqrt.cap_hits == 1);
+        assert(Stats::Sqrt().Calls() == 0);
+
+        Stats::SqrtStats merged = tick.sqrt;
+        merged += tick.sqrt;
+        assert(merged.Calls() == 4 && merged.cap_hits == 2 && merged.octave_max_iterations[30] == Unit::SQRT_MAX_ITER);
+    }
+
+    void TestBudget() {
+        Stats::OpCounts budget;
+        budget.mul = 100;
+        budget.div = 10;
+        budget.sqrt = 1;
+        budget.newton_iterations = 10;
+
+        Stats::Reset();
+        Unit x = 1;
+        for (int i = 0; i < 50; ++i) {
+            x = x * Unit(1);
+        }
+        assert(Stats::Counters().Within(budget));
+
+        // an accidental O(n^2) loop blows the multiply budget
+        for (int i = 0; i < 20; ++i) {
+            for (int j = 0; j < 20; ++j) {
+                x = x * Unit(1);
+            }
+        }
+        assert(!Stats::Counters().Within(budget));
+    }
+
+    void TestThreadLocal() {
+        Stats::Reset();
+        std::thread worker([] {
+            Unit x = Unit(3) * Unit(3);
+            (void)x;
+            assert(Stats::Counters().mul == 1);
+        });
+        worker.join();
+        assert(Stats::Counters().mul == 0);
+    }
+
+    TestStats() {
+        TestCounts();
+        TestScopes();
+        TestResetInsideScope();
+        TestSqrtHistogram();
+        TestBudget();
+        TestThreadLocal();
+    }
+};
+
+static TestStats __test_stats;
+
+int main(void) {}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations made while a NoAllocScope is open on the calling thread.
+//
+// Replaces the global operator new family and, on glibc builds without sanitizers, malloc, calloc
+// and realloc as well. The replacements are not inline, so include this header in exactly one
+// translation unit of a test executable.
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#if defined(__has_feature)
+#if !__has_feature(address_sanitizer) && !__has_feature(thread_sanitizer) && !__has_feature(memory_sanitizer)
+#define GEKKO_TEST_HOOK_MALLOC 1
+#endif
+#else
+#define GEKKO_TEST_HOOK_MALLOC 1
+#endif
+#endif
+
+namespace Gekko::Test {
+
+    struct AllocCounter {
+        bool armed = false;
+        uint64_t count = 0;
+    };
+
+    inline AllocCounter& Allocs() {
+        thread_local AllocCounter counter;
+        return counter;
+    }
+
+    inline void NoteAlloc() {
+        AllocCounter& c = Allocs();
+        if (c.armed) {
+            c.count++;
+        }
+    }
+
+    // allocations on this thread between construction and Count()
+    class NoAllocScope {
+    public:
+        NoAllocScope() : _start(Allocs().count), _was_armed(Allocs().armed) {
+            Allocs().armed = true;
+        }
+
+        ~NoAllocScope() {
+            Allocs().armed = _was_armed;
+        }
+
+        uint64_t Count() const {
+            return Allocs().count - _start;
+        }
+
+        NoAllocScope(const NoAllocScope&) = delete;
+        NoAllocScope& operator=(const NoAllocScope&) = delete;
+
+    private:
+        uint64_t _start;
+        bool _was_armed;
+    };
+}
+
+#if defined(GEKKO_TEST_HOOK_MALLOC)
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size) {
+        Gekko::Test::NoteAlloc();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) {
+        Gekko::Test::NoteAlloc();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        Gekko::Test::NoteAlloc();
+        return __libc_realloc(ptr, size);
+    }
+}
+#endif
+
+namespace Gekko::Test {
+
+    // operator new goes through malloc, so it only counts itself when malloc is not hooked
+    inline void* CountedNew(std::size_t size) {
+#if !defined(GEKKO_TEST_HOOK_MALLOC)
+        NoteAlloc();
+#endif
+        if (void* p = std::malloc(size ? size : 1)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    inline void* CountedNewAligned(std::size_t size, std::align_val_t align) {
+        NoteAlloc();
+        std::size_t a = static_cast<std::size_t>(align);
+        std::size_t rounded = ((size ? size : 1) + a - 1) / a * a;
+#if defined(_MSC_VER)
+        void* p = _aligned_malloc(rounded, a);
+#else
+        void* p = std::aligned_alloc(a, rounded);
+#endif
+        if (p) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    inline void FreeAligned(void* p) {
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) {
+    return Gekko::Test::CountedNew(size);
+}
+
+void* operator new[](std::size_t size) {
+    return Gekko::Test::CountedNew(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Gekko::Test::CountedNew(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Gekko::Test::CountedNew(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return Gekko::Test::CountedNewAligned(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return Gekko::Test::CountedNewAligned(size, align);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    Gekko::Test::FreeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    Gekko::Test::FreeAligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    Gekko::Test::FreeAligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    Gekko::Test::FreeAligned(p);
+}
@@ -0,0 +1,337 @@
+#include "gekko_math.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Gekko::Math;
+
+// Error analysis for the Unit math functions against exact integer references.
+// Errors are measured in raw LSBs (1 / Unit::ONE). Unary functions can be swept
+// exhaustively over their whole raw domain; every function can be sampled
+// stratified by input magnitude (one stratum per power of two of |raw|).
+//
+// Covered: sqrt (SqrtNewton), division and multiplication. The library has no
+// rsqrt, trig or exp/log yet; new functions only need a reference and an entry in Functions().
+namespace {
+
+    const int OCTAVES = 32;   // 0 for raw 0, 1 + floor(log2|raw|) otherwise
+
+    int Octave(int64_t raw) {
+        uint64_t m = static_cast<uint64_t>(raw < 0 ? -raw : raw);
+        int o = 0;
+        while (m) {
+            m >>= 1;
+            ++o;
+        }
+        return o;
+    }
+
+    // first raw value of an octave and its size
+    int64_t OctaveStart(int o) {
+        return o == 0 ? 0 : (int64_t(1) << (o - 1));
+    }
+
+    int64_t OctaveSize(int o) {
+        return o == 0 ? 1 : (int64_t(1) << (o - 1));
+    }
+
+    uint64_t SplitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // round(n / d) with ties away from zero, d != 0
+    int64_t DivRound(int64_t n, int64_t d) {
+        bool neg = (n < 0) != (d < 0);
+        uint64_t un = static_cast<uint64_t>(n < 0 ? -n : n);
+        uint64_t ud = static_cast<uint64_t>(d < 0 ? -d : d);
+        int64_t q = static_cast<int64_t>((2 * un + ud) / (2 * ud));
+        return neg ? -q : q;
+    }
+
+    // a reference either yields the exact rounded raw result or reports the input as outside the domain
+    struct Sample {
+        int32_t a;
+        int32_t b;
+    };
+
+    struct Function {
+        const char* name;
+        int arity;
+        int32_t min_a;   // valid raw domain of the first operand
+        int32_t max_a;
+        bool (*reference)(int32_t a, int32_t b, int64_t& out);
+        int32_t (*eval)(int32_t a, int32_t b);
+    };
+
+    bool SqrtRef(int32_t a, int32_t, int64_t& out) {
+        uint64_t v = static_cast<uint64_t>(a) << 15;
+        uint64_t s = Detail::ISqrt(v);
+        out = static_cast<int64_t>(s + (s * s + s < v ? 1 : 0));
+        return true;
+    }
+
+    int32_t SqrtEval(int32_t a, int32_t) {
+        return Unit::SqrtNewton(Unit::From(a)).Raw();
+    }
+
+    bool DivRef(int32_t a, int32_t b, int64_t& out) {
+        if (b == 0 || b == INT32_MIN) {
+            return false;
+        }
+        out = DivRound(static_cast<int64_t>(a) * Unit::ONE, b);
+        return out >= INT32_MIN && out <= INT32_MAX;
+    }
+
+    int32_t DivEval(int32_t a, int32_t b) {
+        return (Unit::From(a) / Unit::From(b)).Raw();
+    }
+
+    bool MulRef(int32_t a, int32_t b, int64_t& out) {
+        out = DivRound(static_cast<int64_t>(a) * b, Unit::ONE);
+        return out >= INT32_MIN && out <= INT32_MAX;
+    }
+
+    int32_t MulEval(int32_t a, int32_t b) {
+        return (Unit::From(a) * Unit::From(b)).Raw();
+    }
+
+    const std::vector<Function>& Functions() {
+        static const std::vector<Function> functions = {
+            { "sqrt", 1, 0, INT32_MAX, SqrtRef, SqrtEval },
+            { "div", 2, INT32_MIN + 1, INT32_MAX, DivRef, DivEval },
+            { "mul", 2, INT32_MIN + 1, INT32_MAX, MulRef, MulEval },
+        };
+        return functions;
+    }
+
+    struct ErrorStats {
+        uint64_t count = 0;
+        uint64_t skipped = 0;      // inputs outside the reference domain (overflow, division by zero)
+        uint64_t abs_sum = 0;
+        int64_t max_abs = -1;
+        Sample max_at = { 0, 0 };
+        int64_t max_result = 0;
+        int64_t max_expected = 0;
+        uint64_t histogram[5] = {};   // |err| 0, 1, 2-3, 4-15, 16+
+        int64_t octave_max[OCTAVES];  // by octave of the first operand
+
+        ErrorStats() {
+            std::fill(octave_max, octave_max + OCTAVES, int64_t(-1));
+        }
+
+        void Add(const Sample& s, int64_t result, int64_t expected) {
+            int64_t err = result - expected;
+            int64_t abs_err = err < 0 ? -err : err;
+            count++;
+            abs_sum += static_cast<uint64_t>(abs_err);
+            if (abs_err > max_abs) {
+                max_abs = abs_err;
+                max_at = s;
+                max_result = result;
+                max_expected = expected;
+            }
+            int o = Octave(s.a);
+            octave_max[o] = std::max(octave_max[o], abs_err);
+            int bin = abs_err == 0 ? 0 : abs_err == 1 ? 1 : abs_err < 4 ? 2 : abs_err < 16 ? 3 : 4;
+            histogram[bin]++;
+        }
+
+        void Merge(const ErrorStats& o) {
+            count += o.count;
+            skipped += o.skipped;
+            abs_sum += o.abs_sum;
+            if (o.max_abs > max_abs) {
+                max_abs = o.max_abs;
+                max_at = o.max_at;
+                max_result = o.max_result;
+                max_expected = o.max_expected;
+            }
+            for (int i = 0; i < 5; ++i) {
+                histogram[i] += o.histogram[i];
+            }
+            for (int i = 0; i < OCTAVES; ++i) {
+                octave_max[i] = std::max(octave_max[i], o.octave_max[i]);
+            }
+        }
+    };
+
+    void Evaluate(const Function& f, const Sample& s, ErrorStats& stats) {
+        int64_t expected;
+        if (s.a < f.min_a || s.a > f.max_a || !f.reference(s.a, s.b, expected)) {
+            stats.skipped++;
+            return;
+        }
+        stats.Add(s, f.eval(s.a, s.b), expected);
+    }
+
+    struct Config {
+        std::string function = "all";
+        bool exhaustive = false;
+        uint64_t samples = 4096;   // per stratum
+        unsigned threads = 0;
+        uint64_t seed = 0x4572724Aull;
+    };
+
+    // splits [0, jobs) over the worker threads, each job gets its own stats merged at the end
+    template <typename Job>
+    ErrorStats RunParallel(unsigned threads, uint64_t jobs, Job job) {
+        std::atomic<uint64_t> next{ 0 };
+        std::vector<ErrorStats> partial(threads);
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                for (uint64_t j = next++; j < jobs; j = next++) {
+                    job(j, partial[t]);
+                }
+            });
+        }
+        ErrorStats total;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool[t].join();
+            total.Merge(partial[t]);
+        }
+        return total;
+    }
+
+    // every raw value of the first operand, in 2^16-wide chunks
+    ErrorStats Exhaustive(const Function& f, unsigned threads) {
+        const int64_t chunk = 1 << 16;
+        const int64_t lo = f.min_a;
+        const int64_t span = static_cast<int64_t>(f.max_a) - lo + 1;
+        const uint64_t jobs = static_cast<uint64_t>((span + chunk - 1) / chunk);
+        return RunParallel(threads, jobs, [&](uint64_t j, ErrorStats& stats) {
+            int64_t begin = lo + static_cast<int64_t>(j) * chunk;
+            int64_t end = std::min(begin + chunk, lo + span);
+            for (int64_t a = begin; a < end; ++a) {
+                Evaluate(f, { static_cast<int32_t>(a), 0 }, stats);
+            }
+        });
+    }
+
+    int32_t RandomInOctave(uint64_t& rng, int octave, bool negative) {
+        int64_t v = OctaveStart(octave) + static_cast<int64_t>(SplitMix(rng) % static_cast<uint64_t>(OctaveSize(octave)));
+        if (negative) {
+            v = -v;
+        }
+        return static_cast<int32_t>(std::max<int64_t>(std::min<int64_t>(v, INT32_MAX), INT32_MIN + 1));
+    }
+
+    // 'samples' inputs per octave (and per sign where the domain allows it); binary functions
+    // stratify over the octave pair so tiny divisors and huge numerators are both covered
+    ErrorStats Stratified(const Function& f, const Config& cfg) {
+        const bool signed_a = f.min_a < 0;
+        const int sides_a = signed_a ? 2 : 1;
+        const int strata_b = f.arity == 2 ? OCTAVES * 2 : 1;
+        const uint64_t jobs = static_cast<uint64_t>(OCTAVES) * sides_a * strata_b;
+        return RunParallel(cfg.threads, jobs, [&](uint64_t j, ErrorStats& stats) {
+            int oa = static_cast<int>(j % OCTAVES);
+            bool neg_a = (j / OCTAVES) % sides_a == 1;
+            uint64_t jb = j / (OCTAVES * sides_a);
+            int ob = static_cast<int>(jb % OCTAVES);
+            bool neg_b = jb / OCTAVES == 1;
+            uint64_t rng = cfg.seed ^ (j * 0xD1B54A32D192ED03ull);
+            uint64_t n = std::min<uint64_t>(cfg.samples, f.arity == 1 ? OctaveSize(oa) : cfg.samples);
+            for (uint64_t i = 0; i < n; ++i) {
+                Sample s;
+                s.a = f.arity == 1 && static_cast<uint64_t>(OctaveSize(oa)) <= cfg.samples
+                    ? static_cast<int32_t>(OctaveStart(oa) + static_cast<int64_t>(i)) * (neg_a ? -1 : 1)
+                    : RandomInOctave(rng, oa, neg_a);
+                s.b = f.arity == 2 ? RandomInOctave(rng, ob, neg_b) : 0;
+                Evaluate(f, s, stats);
+            }
+        });
+    }
+
+    void Report(const Function& f, const ErrorStats& s, double seconds, bool exhaustive) {
+        std::printf("\n%s (%s): %llu inputs in %.2fs, %llu outside the reference domain\n", f.name,
+            exhaustive ? "exhaustive" : "stratified",
+            static_cast<unsigned long long>(s.count), seconds, static_cast<unsigned long long>(s.skipped));
+        if (s.count == 0) {
+            return;
+        }
+        std::printf("  max |err| %lld LSB at a=%d", static_cast<long long>(s.max_abs), s.max_at.a);
+        if (f.arity == 2) {
+            std::printf(" b=%d", s.max_at.b);
+        }
+        std::printf(" (got %lld, expected %lld)\n", static_cast<long long>(s.max_result), static_cast<long long>(s.max_expected));
+        std::printf("  mean |err| %.4f LSB\n", static_cast<double>(s.abs_sum) / s.count);
+        std::printf("  |err| histogram: 0: %llu  1: %llu  2-3: %llu  4-15: %llu  16+: %llu\n",
+            static_cast<unsigned long long>(s.histogram[0]), static_cast<unsigned long long>(s.histogram[1]),
+            static_cast<unsigned long long>(s.histogram[2]), static_cast<unsigned long long>(s.histogram[3]),
+            static_cast<unsigned long long>(s.histogram[4]));
+        std::printf("  max |err| by |a| range (raw):\n");
+        for (int o = 0; o < OCTAVES; ++o) {
+            if (s.octave_max[o] < 0) {
+                continue;
+            }
+            std::printf("    [%11lld, %11lld] %lld\n", static_cast<long long>(OctaveStart(o)),
+                static_cast<long long>(OctaveStart(o) + OctaveSize(o) - 1), static_cast<long long>(s.octave_max[o]));
+        }
+    }
+
+    Config Parse(int argc, char** argv) {
+        Config cfg;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strncmp(arg, "--function=", 11) == 0) {
+                cfg.function = arg + 11;
+            }
+            else if (std::strcmp(arg, "--exhaustive") == 0) {
+                cfg.exhaustive = true;
+            }
+            else if (std::strncmp(arg, "--samples=", 10) == 0) {
+                cfg.samples = std::max<uint64_t>(1, std::strtoull(arg + 10, nullptr, 10));
+            }
+            else if (std::strncmp(arg, "--threads=", 10) == 0) {
+                cfg.threads = static_cast<unsigned>(std::atoi(arg + 10));
+            }
+            else if (std::strncmp(arg, "--seed=", 7) == 0) {
+                cfg.seed = std::strtoull(arg + 7, nullptr, 0);
+            }
+            else {
+                std::fprintf(stderr,
+                    "usage: %s [--function=sqrt|div|mul|all] [--exhaustive] [--samples=N] [--threads=N] [--seed=N]\n"
+                    "  --exhaustive sweeps every raw input of unary functions; binary functions stay stratified\n",
+                    argv[0]);
+                std::exit(2);
+            }
+        }
+        if (cfg.threads == 0) {
+            cfg.threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return cfg;
+    }
+}
+
+int main(int argc, char** argv) {
+    Config cfg = Parse(argc, argv);
+    std::printf("threads: %u\n", cfg.threads);
+    bool any = false;
+    for (const Function& f : Functions()) {
+        if (cfg.function != "all" && cfg.function != f.name) {
+            continue;
+        }
+        any = true;
+        bool exhaustive = cfg.exhaustive && f.arity == 1;
+        auto t0 = std::chrono::steady_clock::now();
+        ErrorStats stats = exhaustive ? Exhaustive(f, cfg.threads) : Stratified(f, cfg);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        Report(f, stats, seconds, exhaustive);
+    }
+    if (!any) {
+        std::fprintf(stderr, "unknown function '%s'\n", cfg.function.c_str());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,450 @@
+#include "gekko_math.h"
+#include "gekko_easing.h"
+#include "gekko_keyframes.h"
+#include "gekko_noise.h"
+#include "gekko_random.h"
+#include "gekko_spline.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Gekko::Math;
+
+// Golden corpus for cross-compiler determinism.
+// --generate writes inputs and the raw outputs of every operator and function, grouped by
+// category; --check re-evaluates the inputs stored in a corpus and compares every output,
+// printing one FNV-1a hash per category so builds can also be compared by hash alone.
+// Inputs avoid signed overflow (undefined behaviour) so every conforming build must agree.
+namespace {
+
+    const int CASES = 256;
+    const char* HEADER = "# GekkoMath golden corpus v1";
+
+    struct Outcome {
+        bool threw = false;
+        std::vector<int64_t> values;
+    };
+
+    using Inputs = std::vector<int32_t>;
+
+    struct Category {
+        const char* name;
+        int arity;
+        int32_t (*clamp)(int32_t v, int index);   // maps a random raw value into the safe domain
+        void (*eval)(const Inputs& in, Outcome& out);
+    };
+
+    uint32_t FloatBits(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    Unit U(int32_t raw) {
+        return Unit::From(raw);
+    }
+
+    Vec3 V(const Inputs& in, int first) {
+        return Vec3(U(in[first]), U(in[first + 1]), U(in[first + 2]));
+    }
+
+    void Push(Outcome& out, const Unit& u) {
+        out.values.push_back(u.Raw());
+    }
+
+    void Push(Outcome& out, const Vec3& v) {
+        Push(out, v.x);
+        Push(out, v.y);
+        Push(out, v.z);
+    }
+
+    uint64_t Seed(const Inputs& in) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(in[0])) << 32 | static_cast<uint32_t>(in[1]);
+    }
+
+    // domains
+    int32_t Any(int32_t v, int) {
+        return v == INT32_MIN ? INT32_MAX : v;
+    }
+
+    // sums and differences of two values stay in range
+    int32_t Half(int32_t v, int) {
+        return v / 2;
+    }
+
+    // leaves room for three more additions
+    int32_t Quarter(int32_t v, int) {
+        return v / 4;
+    }
+
+    int32_t Negative(int32_t v, int) {
+        return v < 0 ? v : -v - 1;
+    }
+
+    int32_t NonNegative(int32_t v, int) {
+        return v < 0 ? -(v + 1) : v;
+    }
+
+    // the last unit of the raw range, where SqrtNewton's x + u / x once overflowed int32
+    int32_t TopUnit(int32_t v, int) {
+        return INT32_MAX - static_cast<int32_t>(static_cast<uint32_t>(v) % Unit::ONE);
+    }
+
+    // keeps vector components small enough that Dot sums three products without overflow
+    int32_t Small(int32_t v, int) {
+        return v % (128 * Unit::ONE);
+    }
+
+    // a sample time within four units of the keys first, then Small key data
+    int32_t KeyTime(int32_t v, int index) {
+        return index == 0 ? v % (4 * Unit::ONE) : Small(v, index);
+    }
+
+    const std::vector<Category>& Categories() {
+        static const std::vector<Category> categories = {
+            { "unit.add", 2, Half, [](const Inputs& in, Outcome& out) { Push(out, U(in[0]) + U(in[1])); } },
+            { "unit.sub", 2, Half, [](const Inputs& in, Outcome& out) { Push(out, U(in[0]) - U(in[1])); } },
+            { "unit.neg", 1, Any, [](const Inputs& in, Outcome& out) { Push(out, -U(in[0])); } },
+            { "unit.mul", 2, Any, [](const Inputs& in, Outcome& out) { Push(out, U(in[0]) * U(in[1])); } },
+            { "unit.div", 2, Any, [](const Inputs& in, Outcome& out) { Push(out, U(in[0]) / U(in[1])); } },
+            { "unit.compound", 2, Half, [](const Inputs& in, Outcome& out) {
+                Unit a = U(in[0]);
+                a += U(in[1]);
+                Push(out, a);
+                a -= U(in[1]);
+                Push(out, a);
+                a *= U(in[1]);
+                Push(out, a);
+                if (in[1] != 0) {
+                    a /= U(in[1]);
+                    Push(out, a);
+                }
+            } },
+            { "unit.compare", 2, Any, [](const Inputs& in, Outcome& out) {
+                Unit a = U(in[0]), b = U(in[1]);
+                out.values.push_back((a < b) | (a <= b) << 1 | (a > b) << 2 | (a >= b) << 3 | (a == b) << 4 | (a != b) << 5);
+                out.values.push_back((a < in[1]) | (a <= in[1]) << 1 | (a > in[1]) << 2 | (a >= in[1]) << 3);
+            } },
+            { "unit.minmax", 2, Any, [](const Inputs& in, Outcome& out) {
+                Push(out, Min(U(in[0]), U(in[1])));
+                Push(out, Max(U(in[0]), U(in[1])));
+            } },
+            { "unit.sqrt", 1, NonNegative, [](const Inputs& in, Outcome& out) { Push(out, Unit::SqrtNewton(U(in[0]))); } },
+            { "unit.sqrt_negative", 1, Negative, [](const Inputs& in, Outcome& out) { Push(out, Unit::SqrtNewton(U(in[0]))); } },
+            { "unit.asfloat", 1, Any, [](const Inputs& in, Outcome& out) { out.values.push_back(FloatBits(U(in[0]).AsFloat())); } },
+            { "unit.from_int", 1, Any, [](const Inputs& in, Outcome& out) { Push(out, Unit(in[0] % 65536)); } },
+            { "vec3.add", 6, Half, [](const Inputs& in, Outcome& out) { Push(out, V(in, 0) + V(in, 3)); } },
+            { "vec3.sub", 6, Half, [](const Inputs& in, Outcome& out) { Push(out, V(in, 0) - V(in, 3)); } },
+            { "vec3.mul", 6, Any, [](const Inputs& in, Outcome& out) { Push(out, V(in, 0) * V(in, 3)); } },
+            { "vec3.div", 6, Any, [](const Inputs& in, Outcome& out) { Push(out, V(in, 0) / V(in, 3)); } },
+            { "vec3.scalar", 4, Half, [](const Inputs& in, Outcome& out) {
+                Vec3 v = V(in, 0);
+                Unit s = U(in[3]);
+                Push(out, v + s);
+                Push(out, v - s);
+                Push(out, v * s);
+                if (in[3] != 0) {
+                    Push(out, v / s);
+                }
+            } },
+            { "vec3.compound", 6, Quarter, [](const Inputs& in, Outcome& out) {
+                Vec3 v = V(in, 0);
+                v += V(in, 3);
+                Push(out, v);
+                v -= V(in, 3);
+                Push(out, v);
+                v += U(in[3]);
+                Push(out, v);
+                v -= U(in[4]);
+                Push(out, v);
+                v *= V(in, 3);
+                Push(out, v);
+                v *= U(in[5]);
+                Push(out, v);
+            } },
+            { "vec3.dot", 6, Small, [](const Inputs& in, Outcome& out) { Push(out, V(in, 0).Dot(V(in, 3))); } },
+            { "vec3.equal", 6, Any, [](const Inputs& in, Outcome& out) {
+                Vec3 a = V(in, 0);
+                Vec3 b = (in[5] & 1) ? a : V(in, 3);
+                out.values.push_back((a == b) | (a != b) << 1);
+            } },
+            { "vec3.asfloat", 3, Any, [](const Inputs& in, Outcome& out) {
+                Vec3F f = V(in, 0).AsFloat();
+                out.values.push_back(FloatBits(f.x));
+                out.values.push_back(FloatBits(f.y));
+                out.values.push_back(FloatBits(f.z));
+            } },
+            // random streams from the seed in[0], in[1]; appended last so earlier categories keep their inputs
+            { "random.next", 2, Any, [](const Inputs& in, Outcome& out) {
+                Random rng(Seed(in));
+                for (int i = 0; i < 8; ++i) out.values.push_back(rng.Next());
+            } },
+            { "random.range", 4, Any, [](const Inputs& in, Outcome& out) {
+                Random rng(Seed(in));
+                Unit lo = Min(U(in[2]), U(in[3])), hi = Max(U(in[2]), U(in[3]));
+                for (int i = 0; i < 4; ++i) Push(out, rng.Range(lo, hi));
+                Push(out, rng.NextUnit());
+                out.values.push_back(rng.Below(static_cast<uint32_t>(in[3])));
+            } },
+            { "random.shapes", 2, Any, [](const Inputs& in, Outcome& out) {
+                Random rng(Seed(in));
+                Push(out, rng.InSphere(Unit(2)));
+                Push(out, rng.InDisc(Unit(2)));
+                Push(out, rng.Direction());
+                Push(out, rng.Gaussian(Unit(1), Unit::From(Unit::HALF)));
+            } },
+            { "random.batch", 4, Any, [](const Inputs& in, Outcome& out) {
+                RandomBatch rng(Seed(in));
+                Unit lo = Min(U(in[2]), U(in[3])), hi = Max(U(in[2]), U(in[3]));
+                Unit range[7], gauss[5];
+                rng.FillRange(range, 7, lo, hi);
+                rng.FillGaussian(gauss, 5, Unit(0), Unit(1));
+                for (const Unit& u : range) Push(out, u);
+                for (const Unit& u : gauss) Push(out, u);
+            } },
+            // noise at (in[0], in[1], in[2]) with the seed in[3]
+            { "noise.perlin", 4, Any, [](const Inputs& in, Outcome& out) {
+                uint32_t seed = static_cast<uint32_t>(in[3]);
+                Push(out, Perlin(U(in[0]), U(in[1]), seed));
+                Push(out, Perlin(V(in, 0), seed));
+            } },
+            { "noise.simplex", 4, Any, [](const Inputs& in, Outcome& out) {
+                uint32_t seed = static_cast<uint32_t>(in[3]);
+                Push(out, Simplex(U(in[0]), U(in[1]), seed));
+                Push(out, Simplex(V(in, 0), seed));
+            } },
+            // one three-key track at time in[0] in every interpolation
+            { "keyframes.sample", 7, KeyTime, [](const Inputs& in, Outcome& out) {
+                const Keyframe keys[] = { { Unit(0), U(in[1]), U(in[2]), U(in[3]) }, { Unit(1), U(in[4]), U(in[5]), U(in[6]) },
+                    { Unit(3), U(in[2]), U(in[6]), U(in[1]) } };
+                for (Interpolation mode : { Interpolation::Linear, Interpolation::Hermite, Interpolation::Bezier }) {
+                    Push(out, KeyTrack(keys, 3, mode).Sample(U(in[0])));
+                }
+            } },
+            // four control points from in[1..12] as one Bezier and three Catmull-Rom segments, at parameter in[0]
+            { "spline.evaluate", 13, KeyTime, [](const Inputs& in, Outcome& out) {
+                const Vec3 points[] = { V(in, 1), V(in, 4), V(in, 7), V(in, 10) };
+                for (SplineKind kind : { SplineKind::Bezier, SplineKind::CatmullRom }) {
+                    Spline spline(points, 4, kind);
+                    Push(out, spline.Evaluate(U(in[0])));
+                    Push(out, spline.Tangent(U(in[0])));
+                    Vec3 tessellated[4];
+                    spline.Tessellate(0, 3, tessellated);
+                    for (const Vec3& v : tessellated) Push(out, v);
+                    Unit lengths[13];
+                    ArcLengthTable table(spline, 4, lengths);
+                    Push(out, table.Length());
+                    Push(out, table.Parameter(U(in[0] < 0 ? -in[0] : in[0])));
+                }
+            } },
+            // every easing at t = in[0] within a unit of [0, 1], and a tween over in[1] and in[2]
+            { "easing.curves", 3, Small, [](const Inputs& in, Outcome& out) {
+                const Unit t = U(in[0] % (3 * Unit::ONE) - Unit::ONE);
+                for (int e = 0; e <= static_cast<int>(Easing::BounceInOut); ++e) {
+                    Push(out, Ease(static_cast<Easing>(e), t));
+                }
+                Push(out, Tween(U(in[1]), U(in[2]), Unit(2), Easing::BackInOut).Sample(t));
+            } },
+            { "unit.sqrt_top", 1, TopUnit, [](const Inputs& in, Outcome& out) { Push(out, Unit::SqrtNewton(U(in[0]))); } },
+        };
+        return categories;
+    }
+
+    Outcome Evaluate(const Category& c, const Inputs& in) {
+        Outcome out;
+        try {
+            c.eval(in, out);
+        }
+        catch (const std::runtime_error&) {
+            out.threw = true;
+            out.values.clear();
+        }
+        return out;
+    }
+
+    uint64_t SplitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // edge-heavy raw values: zero, one LSB, one and a half unit, powers of two and the extremes
+    const std::vector<int32_t>& EdgeValues() {
+        static std::vector<int32_t> edges;
+        if (edges.empty()) {
+            const int32_t base[] = { 0, 1, 2, 3, Unit::HALF, Unit::ONE - 1, Unit::ONE, Unit::ONE + 1,
+                3 * Unit::HALF, 2 * Unit::ONE, 100 * Unit::ONE, 181, 46341, 65535, 65536,
+                1 << 20, 1 << 24, 1 << 30, INT32_MAX - 1, INT32_MAX };
+            for (int32_t v : base) {
+                edges.push_back(v);
+                edges.push_back(-v);
+            }
+            edges.push_back(INT32_MIN);
+        }
+        return edges;
+    }
+
+    // first the cross product of a few edges, then random values at random magnitudes
+    Inputs MakeInputs(const Category& c, int index, uint64_t& rng) {
+        const std::vector<int32_t>& edges = EdgeValues();
+        Inputs in(c.arity);
+        for (int k = 0; k < c.arity; ++k) {
+            int32_t v;
+            if (index < 64) {
+                int pick = k == 0 ? index / 8 : (index + k * 3) % 8;
+                v = edges[(pick * 5 + k) % edges.size()];
+            }
+            else {
+                uint64_t r = SplitMix(rng);
+                int shift = static_cast<int>(r & 31);
+                v = static_cast<int32_t>(static_cast<uint32_t>(r >> 32) >> shift);
+                v = (r & 32) ? -v : v;
+            }
+            in[k] = c.clamp(v, index);
+        }
+        return in;
+    }
+
+    std::string Format(const Outcome& out) {
+        if (out.threw) {
+            return "throw";
+        }
+        std::ostringstream ss;
+        for (size_t i = 0; i < out.values.size(); ++i) {
+            ss << (i ? " " : "") << out.values[i];
+        }
+        return ss.str();
+    }
+
+    uint64_t Fnv1a(uint64_t hash, const std::string& s) {
+        for (unsigned char ch : s) {
+            hash ^= ch;
+            hash *= 0x100000001B3ull;
+        }
+        hash ^= '\n';
+        hash *= 0x100000001B3ull;
+        return hash;
+    }
+
+    const uint64_t FNV_OFFSET = 0xCBF29CE484222325ull;
+
+    int Generate(const std::string& path) {
+        std::ofstream f(path);
+        if (!f) {
+            std::cerr << "cannot write " << path << "\n";
+            return 1;
+        }
+        f << HEADER << "\n";
+        uint64_t rng = 0x476F6C64656Eull;
+        for (const Category& c : Categories()) {
+            uint64_t hash = FNV_OFFSET;
+            f << "category " << c.name << " " << c.arity << "\n";
+            for (int i = 0; i < CASES; ++i) {
+                Inputs in = MakeInputs(c, i, rng);
+                std::ostringstream line;
+                for (int32_t v : in) {
+                    line << v << " ";
+                }
+                line << ": " << Format(Evaluate(c, in));
+                hash = Fnv1a(hash, line.str());
+                f << line.str() << "\n";
+            }
+            char hex[32];
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+            f << "hash " << c.name << " " << hex << "\n";
+            std::cout << c.name << " " << hex << "\n";
+        }
+        return f.good() ? 0 : 1;
+    }
+
+    int Check(const std::string& path) {
+        std::ifstream f(path);
+        std::string line;
+        if (!f || !std::getline(f, line) || line != HEADER) {
+            std::cerr << "not a golden corpus: " << path << "\n";
+            return 1;
+        }
+
+        std::map<std::string, const Category*> by_name;
+        for (const Category& c : Categories()) {
+            by_name[c.name] = &c;
+        }
+
+        const Category* current = nullptr;
+        uint64_t hash = FNV_OFFSET;
+        int mismatches = 0;
+        int checked = 0;
+        int line_no = 1;
+        while (std::getline(f, line)) {
+            line_no++;
+            std::istringstream ss(line);
+            std::string word;
+            ss >> word;
+            if (word == "category") {
+                std::string name;
+                ss >> name;
+                auto it = by_name.find(name);
+                if (it == by_name.end()) {
+                    std::cerr << "line " << line_no << ": unknown category " << name << "\n";
+                    return 1;
+                }
+                current = it->second;
+                hash = FNV_OFFSET;
+            }
+            else if (word == "hash") {
+                std::string name, expected;
+                ss >> name >> expected;
+                char hex[32];
+                std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+                bool ok = expected == hex;
+                std::cout << name << " " << hex << (ok ? "" : "  MISMATCH (expected " + expected + ")") << "\n";
+                mismatches += ok ? 0 : 1;
+                current = nullptr;
+            }
+            else if (current) {
+                Inputs in;
+                std::istringstream parse(line);
+                for (int k = 0; k < current->arity; ++k) {
+                    int32_t v;
+                    parse >> v;
+                    in.push_back(v);
+                }
+                std::string expected = line.substr(line.find(':') + 2);
+                std::string got = Format(Evaluate(*current, in));
+                std::string actual = line.substr(0, line.find(':') + 2) + got;
+                hash = Fnv1a(hash, actual);
+                if (got != expected) {
+                    if (mismatches < 20) {
+                        std::cerr << current->name << " line " << line_no << ": inputs " << line.substr(0, line.find(':'))
+                            << "expected " << expected << ", got " << got << "\n";
+                    }
+                    mismatches++;
+                }
+                checked++;
+            }
+        }
+        std::cout << checked << " cases, " << mismatches << " mismatches\n";
+        return mismatches == 0 && checked > 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 2 && std::strncmp(argv[1], "--generate=", 11) == 0) {
+        return Generate(argv[1] + 11);
+    }
+    if (argc == 2 && std::strncmp(argv[1], "--check=", 8) == 0) {
+        return Check(argv[1] + 8);
+    }
+    std::cerr << "usage: " << argv[0] << " --generate=<corpus> | --check=<corpus>\n";
+    return 2;
+}
@@ -0,0 +1,116 @@
+#include "gekko_math.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(GEKKO_MATH_COUNT_OPS)
+#error "SqrtConvergence needs GEKKO_MATH_COUNT_OPS"
+#endif
+
+using namespace Gekko::Math;
+
+// SqrtNewton convergence report: iteration histogram, cap hits and the input magnitudes
+// that are slow to converge, collected through Stats::Sqrt(). Inputs are sampled per
+// octave of the raw value (octave o covers [2^(o-1), 2^o)), small octaves exhaustively.
+namespace {
+
+    uint64_t SplitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    struct Config {
+        uint64_t samples = 1 << 16;
+        uint64_t seed = 1;
+    };
+
+    Config Parse(int argc, char** argv) {
+        Config cfg;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strncmp(arg, "--samples=", 10) == 0) {
+                cfg.samples = std::strtoull(arg + 10, nullptr, 10);
+            }
+            else if (std::strncmp(arg, "--seed=", 7) == 0) {
+                cfg.seed = std::strtoull(arg + 7, nullptr, 10);
+            }
+            else {
+                std::fprintf(stderr, "usage: %s [--samples=N per octave] [--seed=N]\n", argv[0]);
+                std::exit(2);
+            }
+        }
+        return cfg;
+    }
+
+    // raw range of an octave as [lo, lo + size)
+    void OctaveRange(int o, double& lo, double& hi) {
+        lo = static_cast<double>(int64_t(1) << (o - 1)) / Unit::ONE;
+        hi = static_cast<double>(int64_t(1) << o) / Unit::ONE;
+    }
+}
+
+int main(int argc, char** argv) {
+    Config cfg = Parse(argc, argv);
+    uint64_t rng = cfg.seed;
+
+    Stats::Reset();
+    for (int o = 1; o < Stats::SQRT_OCTAVES; ++o) {
+        const uint64_t start = uint64_t(1) << (o - 1);
+        const uint64_t size = start;
+        if (size <= cfg.samples) {
+            for (uint64_t i = 0; i < size; ++i) {
+                Unit::SqrtNewton(Unit::From(static_cast<int32_t>(start + i)));
+            }
+        }
+        else {
+            for (uint64_t i = 0; i < cfg.samples; ++i) {
+                Unit::SqrtNewton(Unit::From(static_cast<int32_t>(start + SplitMix(rng) % size)));
+            }
+        }
+    }
+    const Stats::SqrtStats& s = Stats::Sqrt();
+
+    std::printf("SqrtNewton, cap %d iterations, %llu calls\n\n", Unit::SQRT_MAX_ITER,
+        static_cast<unsigned long long>(s.Calls()));
+    std::printf("%10s %12s %8s\n", "iterations", "calls", "share");
+    for (int i = 0; i < Stats::SQRT_HISTOGRAM; ++i) {
+        if (s.iterations[i]) {
+            std::printf("%10d %12llu %7.2f%%\n", i, static_cast<unsigned long long>(s.iterations[i]),
+                100.0 * s.iterations[i] / s.Calls());
+        }
+    }
+    std::printf("cap hits: %llu (%.2f%%)\n\n", static_cast<unsigned long long>(s.cap_hits), 100.0 * s.cap_hits / s.Calls());
+
+    std::printf("%6s %24s %10s %8s %6s %10s\n", "octave", "input range", "calls", "mean it", "max", "cap hits");
+    for (int o = 1; o < Stats::SQRT_OCTAVES; ++o) {
+        double lo, hi;
+        OctaveRange(o, lo, hi);
+        std::printf("%6d [%10.6g, %10.6g) %10llu %8.2f %6u %10llu\n", o, lo, hi,
+            static_cast<unsigned long long>(s.octave_calls[o]), s.MeanIterations(o), s.octave_max_iterations[o],
+            static_cast<unsigned long long>(s.octave_cap_hits[o]));
+    }
+
+    // contiguous octave runs that reach the cap
+    for (int o = 1; o < Stats::SQRT_OCTAVES; ++o) {
+        if (!s.octave_cap_hits[o]) {
+            continue;
+        }
+        int end = o;
+        while (end + 1 < Stats::SQRT_OCTAVES && s.octave_cap_hits[end + 1]) {
+            ++end;
+        }
+        double lo, hi, unused;
+        OctaveRange(o, lo, unused);
+        OctaveRange(end, unused, hi);
+        std::printf("%s[%g, %g)", o == s.FirstCapOctave() ? "\ninputs reaching the cap: " : ", ", lo, hi);
+        o = end;
+    }
+    if (s.cap_hits) {
+        std::printf("\n");
+    }
+    return 0;
+}